@@ -1,46 +1,23 @@
 #include "vpch.h"
 #include "Actor.h"
+#include <bit>
 #include "Actors/IActorSystem.h"
+#include "Actors/ActorNameIndex.h"
+#include "Core/UIDIndex.h"
+#include "Core/WorldDelta.h"
 #include "Components/SpatialComponent.h"
 #include "Components/MeshComponent.h"
 #include "Components/EmptyComponent.h"
 #include "Core/World.h"
 #include "Core/Log.h"
 #include "Core/Camera.h"
-#include "Physics/PhysicsSystem.h"
 
 XMMATRIX Actor::GetWorldMatrix()
 {
-	//@Todo: this isn't going over actor parents and children
+	//Actor parents are covered by the root component's parent, see AddChild().
 	return rootComponent->GetWorldMatrix();
 }
 
-void Actor::UpdateTransform(const XMMATRIX parentWorld)
-{
-	XMMATRIX world = GetTransformMatrix() * parentWorld;
-
-	for (Actor* child : children)
-	{
-		child->UpdateTransform(world);
-	}
-
-	auto rootTransform = rootComponent->GetTransform();
-	rootTransform.world = world;
-	rootComponent->SetTransform(rootTransform);
-}
-
-XMMATRIX Actor::GetTransformMatrix()
-{
-	XMVECTOR rotationOffset = XMVectorSet(0.f, 0.f, 0.f, 1.f);
-
-	if (parent)
-	{
-		rotationOffset = parent->rootComponent->GetLocalPositionV();
-	}
-
-	return rootComponent->GetTransform().GetAffineRotationOrigin(rotationOffset);
-}
-
 XMFLOAT3 Actor::GetPosition()
 {
 	return rootComponent->GetWorldPosition();
@@ -128,37 +105,37 @@ Transform Actor::GetTransform()
 XMFLOAT3 Actor::GetForwardVector()
 {
 	XMFLOAT3 forward;
-	XMStoreFloat3(&forward, XMVector3Normalize(rootComponent->GetTransform().world.r[2]));
+	XMStoreFloat3(&forward, XMVector3Normalize(GetWorldMatrix().r[2]));
 	return forward;
 }
 
 XMVECTOR Actor::GetForwardVectorV()
 {
-	return XMVector3Normalize(rootComponent->GetTransform().world.r[2]);
+	return XMVector3Normalize(GetWorldMatrix().r[2]);
 }
 
 XMFLOAT3 Actor::GetRightVector()
 {
 	XMFLOAT3 right;
-	XMStoreFloat3(&right, XMVector3Normalize(rootComponent->GetTransform().world.r[0]));
+	XMStoreFloat3(&right, XMVector3Normalize(GetWorldMatrix().r[0]));
 	return right;
 }
 
 XMVECTOR Actor::GetRightVectorV()
 {
-	return XMVector3Normalize(rootComponent->GetTransform().world.r[0]);
+	return XMVector3Normalize(GetWorldMatrix().r[0]);
 }
 
 XMFLOAT3 Actor::GetUpVector()
 {
 	XMFLOAT3 up;
-	XMStoreFloat3(&up, XMVector3Normalize(rootComponent->GetTransform().world.r[1]));
+	XMStoreFloat3(&up, XMVector3Normalize(GetWorldMatrix().r[1]));
 	return up;
 }
 
 XMVECTOR Actor::GetUpVectorV()
 {
-	return XMVector3Normalize(rootComponent->GetTransform().world.r[1]);
+	return XMVector3Normalize(GetWorldMatrix().r[1]);
 }
 
 Properties Actor::GetProps()
@@ -206,11 +183,14 @@ std::vector<Properties> Actor::GetAllProps()
 bool Actor::SetName(const std::string newName)
 {
 	//Check for duplicate names in world
-	if (!World::CheckIfActorExistsInWorld(newName))
+	if (!ActorNameIndex::Contains(newName))
 	{
 		World::RemoveActorFromWorld(this);
+		ActorNameIndex::Remove(this);
 		name = newName;
+		ActorNameIndex::Add(this);
 		World::AddActorToWorld(this);
+		MarkSaveDirty();
 
 		return true;
 	}
@@ -218,6 +198,26 @@ bool Actor::SetName(const std::string newName)
 	return false;
 }
 
+void Actor::SetUID(const UID uid_)
+{
+	if (actorSystem)
+	{
+		UIDIndex::RemoveActor(this);
+		uid = uid_;
+		UIDIndex::AddActor(this);
+		return;
+	}
+
+	uid = uid_;
+}
+
+void Actor::SimpleSetName(const std::string newName)
+{
+	ActorNameIndex::Remove(this);
+	name = newName;
+	ActorNameIndex::Add(this);
+}
+
 std::string Actor::GetTypeName()
 {
 	return actorSystem->GetName();
@@ -234,6 +234,7 @@ void Actor::CreateAllComponents()
 void Actor::SetActive(bool newActiveValue)
 {
 	active = newActiveValue;
+	MarkSaveDirty();
 
 	for (auto& componentPair : componentMap)
 	{
@@ -251,6 +252,86 @@ void Actor::SetTickEnabled(bool enabled)
 	tickEnabled = enabled;
 }
 
+TickDecision Actor::ScheduleTick(float deltaTime, uint32_t frameIndex, float& outDeltaTime)
+{
+	outDeltaTime = deltaTime;
+
+	if (tickSchedule.IsEveryFrame())
+	{
+		return TickDecision::Tick;
+	}
+
+	accumulatedTickTime += deltaTime;
+
+	if (ActorTickScheduler::lodEnabled && ActorTickScheduler::hasFocus)
+	{
+		XMVECTOR focusPosition = XMLoadFloat3(&ActorTickScheduler::focusPosition);
+		float distance = XMVector3Length(GetPositionV() - focusPosition).m128_f32[0];
+
+		if (tickSchedule.lodSleepDistance > 0.f && distance > tickSchedule.lodSleepDistance)
+		{
+			//Sleeping actors aren't simulated, so don't hand them the whole nap on wake up.
+			accumulatedTickTime = 0.f;
+			return TickDecision::Sleep;
+		}
+
+		if (tickSchedule.lodNearDistance > 0.f && distance > tickSchedule.lodNearDistance)
+		{
+			//Offset by system index so far away actors don't all tick on the same frame.
+			const uint32_t divisor = std::max(tickSchedule.lodFarFrameDivisor, 1u);
+			if ((frameIndex + static_cast<uint32_t>(actorSystemIndex)) % divisor != 0)
+			{
+				return TickDecision::Skip;
+			}
+		}
+	}
+
+	if (accumulatedTickTime < tickSchedule.interval)
+	{
+		return TickDecision::Skip;
+	}
+
+	outDeltaTime = accumulatedTickTime;
+	accumulatedTickTime = 0.f;
+
+	return TickDecision::Tick;
+}
+
+void Actor::MarkSaveDirty()
+{
+	//Actors are flagged again on spawn once their system has issued them a handle.
+	if (!saveDirty && actorSystem && WorldDelta::IsTracking())
+	{
+		saveDirty = true;
+		WorldDelta::OnActorDirtied(this);
+	}
+}
+
+void Actor::MarkPendingDestroy()
+{
+	pendingDestroy = true;
+
+	//Not SetActive(), child actors outlive this actor and shouldn't be deactivated with it.
+	active = false;
+	for (auto& componentPair : componentMap)
+	{
+		componentPair.second->SetActive(false);
+	}
+
+	//Their root components can't hang off this actor's once it's gone, leave them where they are in the world.
+	for (Actor* child : children)
+	{
+		Transform childTransform = child->GetTransform();
+		childTransform.Decompose(child->GetWorldMatrix());
+
+		rootComponent->RemoveChild(child->rootComponent);
+		child->rootComponent->SetParent(nullptr);
+		child->SetTransform(childTransform);
+		child->parent = nullptr;
+	}
+	children.clear();
+}
+
 void Actor::ToggleActive()
 {
 	active = !active;
@@ -271,6 +352,7 @@ void Actor::AddChild(Actor* actor)
 	//Set parent
 	assert(actor->parent != actor);
 	actor->parent = this;
+	rootComponent->AddChild(actor->rootComponent);
 }
 
 void Actor::AddComponent(Component* component)
@@ -281,14 +363,29 @@ void Actor::AddComponent(Component* component)
 	}
 
 	component->SetOwnerUID(uid);
+	component->SetOwner(this);
+
+	const Symbol componentName(component->name);
+	assert(FindComponentEntry(componentName) == componentMap.end() && "Duplicate Component name (Actor::Create() might be being called twice).");
+
+	auto insertIt = std::upper_bound(componentMap.begin(), componentMap.end(), component->name,
+		[](const std::string& name, const ComponentEntry& entry) { return name < entry.second->name; });
+	componentMap.insert(insertIt, ComponentEntry(componentName, component));
+
+	AddToComponentTypeIndex(component);
 
-	assert(componentMap.find(component->name) == componentMap.end() && "Duplicate Component name (Actor::Create() might be being called twice).");
-	componentMap.emplace(component->name, component);
+	//Components added at runtime only make it into game saves with the rest of the actor's.
+	MarkSaveDirty();
 }
 
 void Actor::RemoveComponent(Component* componentToRemove)
 {
-	componentMap.erase(componentToRemove->name);
+	auto componentIt = FindComponentEntry(Symbol::Find(componentToRemove->name));
+	if (componentIt != componentMap.end())
+	{
+		componentMap.erase(componentIt);
+	}
+	RemoveFromComponentTypeIndex(componentToRemove);
 
 	//Re-parent SpatialComponent's children to its own parent 
 	auto spatialComponent = dynamic_cast<SpatialComponent*>(componentToRemove);
@@ -311,13 +408,13 @@ void Actor::SetEmptyRootComponent()
 
 void Actor::RemoveComponent(std::string componentName)
 {
-	Component* component = componentMap.find(componentName)->second;
+	Component* component = FindComponentEntry(Symbol::Find(componentName))->second;
 	RemoveComponent(component);
 }
 
 Component* Actor::FindComponentAllowNull(const std::string componentName)
 {
-	auto it = componentMap.find(componentName);
+	auto it = FindComponentEntry(Symbol::Find(componentName));
 	if (it == componentMap.end())
 	{
 		Log("Component [%s] not found on Actor [%s] in FindComponentAllowNull",
@@ -329,12 +426,10 @@ Component* Actor::FindComponentAllowNull(const std::string componentName)
 
 Component* Actor::GetComponentByUID(UID componentUID)
 {
-	for (auto& [name, component] : componentMap)
+	Component* component = UIDIndex::FindComponent(componentUID);
+	if (component && component->GetOwnerUID() == uid)
 	{
-		if (component->GetUID() == componentUID)
-		{
-			return component;
-		}
+		return component;
 	}
 
 	Log("Component [%d] not found on Actor [%s].", componentUID, this->name.c_str());
@@ -343,12 +438,11 @@ Component* Actor::GetComponentByUID(UID componentUID)
 
 Component* Actor::GetComponentByName(const std::string componentName)
 {
-	for (auto& componentPair : componentMap)
+	//componentMap is keyed on component name
+	auto componentIt = FindComponentEntry(Symbol::Find(componentName));
+	if (componentIt != componentMap.end())
 	{
-		if (componentPair.second->name == componentName)
-		{
-			return componentPair.second;
-		}
+		return componentIt->second;
 	}
 
 	Log("Component [%s] not found on Actor [%s].", componentName.c_str(), this->name.c_str());
@@ -374,18 +468,34 @@ bool Actor::CanBeTransparentlyOccluded()
 	return false;
 }
 
-bool Actor::HasTag(const std::string& tag)
+bool Actor::HasTag(Symbol tag)
+{
+	return std::binary_search(tags.begin(), tags.end(), tag);
+}
+
+void Actor::AddTag(Symbol tag)
 {
-	return tags.find(tag) != tags.end();
+	auto tagIt = std::lower_bound(tags.begin(), tags.end(), tag);
+	if (tagIt == tags.end() || *tagIt != tag)
+	{
+		tags.insert(tagIt, tag);
+	}
+}
+
+std::vector<Actor::ComponentEntry>::iterator Actor::FindComponentEntry(Symbol componentName)
+{
+	return std::find_if(componentMap.begin(), componentMap.end(), [componentName](const ComponentEntry& entry) {
+		return entry.first == componentName;
+	});
 }
 
 void Actor::SetMeshesToDynamicPhysicsState()
 {
 	for (auto mesh : GetComponentsOfType<MeshComponent>())
 	{
-		PhysicsSystem::ReleasePhysicsActor(mesh);
+		mesh->ReleasePhysicsActor();
 		mesh->isStatic = false;
-		PhysicsSystem::CreatePhysicsActor(mesh, PhysicsType::Dynamic, this);
+		mesh->CreateRigidPhysicsActor();
 	}
 }
 
@@ -393,8 +503,81 @@ void Actor::SetMeshesToStaticPhysicsState()
 {
 	for (auto mesh : GetComponentsOfType<MeshComponent>())
 	{
-		PhysicsSystem::ReleasePhysicsActor(mesh);
+		mesh->ReleasePhysicsActor();
 		mesh->isStatic = true;
-		PhysicsSystem::CreatePhysicsActor(mesh, PhysicsType::Static, this);
+		mesh->CreateRigidPhysicsActor();
 	}
 }
+
+void Actor::AddToComponentTypeIndex(Component* component)
+{
+	//A stale index is rebuilt from componentMap on the next query
+	if (componentTypeIndexVersion != ComponentQueryRegistry::GetVersion())
+	{
+		return;
+	}
+
+	uint64_t matchMask = ComponentQueryRegistry::GetMatchMask(component);
+	componentTypeMask |= matchMask;
+
+	while (matchMask)
+	{
+		const uint32_t queryID = static_cast<uint32_t>(std::countr_zero(matchMask));
+		matchMask &= matchMask - 1;
+
+		auto insertIt = std::upper_bound(componentsByType.begin(), componentsByType.end(), queryID,
+			[component](uint32_t id, const TypedComponentEntry& entry) {
+				if (id != entry.queryID) return id < entry.queryID;
+				return component->name < entry.component->name;
+			});
+		componentsByType.insert(insertIt, TypedComponentEntry{ queryID, component });
+	}
+}
+
+void Actor::RemoveFromComponentTypeIndex(Component* component)
+{
+	std::erase_if(componentsByType, [component](const TypedComponentEntry& entry) {
+		return entry.component == component;
+	});
+
+	componentTypeMask = 0;
+	for (const TypedComponentEntry& entry : componentsByType)
+	{
+		componentTypeMask |= 1ull << entry.queryID;
+	}
+}
+
+void Actor::RebuildComponentTypeIndex()
+{
+	componentTypeMask = 0;
+	componentsByType.clear();
+	componentTypeIndexVersion = ComponentQueryRegistry::GetVersion();
+
+	//componentMap is in name order, so appending then a stable sort on query type keeps names ordered.
+	for (auto& [componentName, component] : componentMap)
+	{
+		uint64_t matchMask = ComponentQueryRegistry::GetMatchMask(component);
+		componentTypeMask |= matchMask;
+
+		while (matchMask)
+		{
+			const uint32_t queryID = static_cast<uint32_t>(std::countr_zero(matchMask));
+			matchMask &= matchMask - 1;
+			componentsByType.emplace_back(TypedComponentEntry{ queryID, component });
+		}
+	}
+
+	std::stable_sort(componentsByType.begin(), componentsByType.end(),
+		[](const TypedComponentEntry& a, const TypedComponentEntry& b) { return a.queryID < b.queryID; });
+}
+
+std::pair<const TypedComponentEntry*, const TypedComponentEntry*> Actor::FindComponentTypeRange(uint32_t queryID)
+{
+	auto first = std::lower_bound(componentsByType.begin(), componentsByType.end(), queryID,
+		[](const TypedComponentEntry& entry, uint32_t id) { return entry.queryID < id; });
+	auto last = std::upper_bound(first, componentsByType.end(), queryID,
+		[](uint32_t id, const TypedComponentEntry& entry) { return id < entry.queryID; });
+
+	const TypedComponentEntry* data = componentsByType.data();
+	return { data + (first - componentsByType.begin()), data + (last - componentsByType.begin()) };
+}
@@ -7,6 +7,9 @@
 #include "Core/Transform.h"
 #include "Core/Properties.h"
 #include "Core/UID.h"
+#include "Core/Symbol.h"
+#include "TickSchedule.h"
+#include "Components/ComponentTypeQuery.h"
 
 class Component;
 struct SpatialComponent;
@@ -20,8 +23,6 @@ public:
 	Actor() {}
 
 	XMMATRIX GetWorldMatrix();
-	void UpdateTransform(const XMMATRIX parentWorld);
-	XMMATRIX GetTransformMatrix();
 	void SetTransform(const Transform transform);
 	Transform GetTransform();
 
@@ -66,6 +67,11 @@ public:
 	//Called after Start()
 	virtual void LateStart() {}
 
+	//Called as the actor's world is moved in and out of WorldCache. Start() doesn't run again on resume,
+	//reset anything that only lasts a visit to the world here (e.g. UI shown, one use flags).
+	virtual void OnWorldSuspended() {}
+	virtual void OnWorldResumed() {}
+
 	//Called once per frame to update actor and its components
 	virtual void Tick(float deltaTime) {}
 
@@ -79,11 +85,11 @@ public:
 	//Do not override this direcly. ACTOR_SYSTEM macro overrides instead.
 	virtual void Destroy() {}
 
-	//Iterates over every actor from the actor's system to avoid a rename collision. bool denotes if collision occured.
+	//Checks ActorNameIndex to avoid a rename collision. bool denotes if collision occured.
 	bool SetName(const std::string newName);
 
 	//Use this for when world state update order is an issue (e.g. ActorSystem, serialisation, WorldEditor)
-	void SimpleSetName(const std::string newName) { name = newName; }
+	void SimpleSetName(const std::string newName);
 
 	std::string GetName() { return name; }
 
@@ -97,15 +103,29 @@ public:
 
 	bool IsActive() { return active; }
 
-	void SetVisibility(bool visibility) { visible = visibility; }
+	void SetVisibility(bool visibility) { visible = visibility; MarkSaveDirty(); }
 	bool IsVisible() { return visible; }
 
 	void SetTickEnabled(bool enabled);
 	inline bool IsTickEnabled() { return tickEnabled; }
 
+	//Called by ActorSystem::Tick() for active, tick enabled actors to decide whether Tick() runs this frame.
+	//outDeltaTime is the time accumulated since the actor last ticked.
+	TickDecision ScheduleTick(float deltaTime, uint32_t frameIndex, float& outDeltaTime);
+
+	//Set by ActorSystem::QueueRemove(). The actor stays in its system, inactive, until the next flush.
+	void MarkPendingDestroy();
+	bool IsPendingDestroy() { return pendingDestroy; }
+
+	//Flags the actor for the next game save, see WorldDelta. Call after writing saved props directly.
+	void MarkSaveDirty();
+	void ClearSaveDirty() { saveDirty = false; }
+	bool IsSaveDirty() { return saveDirty; }
+
 	//Set Actor and components active field as opposite of what it currently is.
 	void ToggleActive();
 
+	//Child actors' root components are parented to this actor's, so they move with it.
 	void AddChild(Actor* actor);
 
 	void AddComponent(Component* component);
@@ -118,6 +138,9 @@ public:
 
 	SpatialComponent& GetRootComponent() { return *rootComponent; }
 
+	//Tick interval and distance LOD. Set in Create() or Start(), it isn't serialised.
+	TickSchedule tickSchedule;
+
 	Component* FindComponentAllowNull(const std::string componentName);
 
 	template <typename T>
@@ -128,27 +151,30 @@ public:
 
 	std::vector<Component*> GetAllComponents();
 
+	//Components that are a T (including derived types), in component name order. Doesn't allocate.
+	//The view is invalidated by adding or removing components on this actor.
 	template <typename T>
-	std::vector<T*> GetComponentsOfType()
+	ComponentTypeView<T> GetComponentsOfType()
 	{
-		std::vector<T*> outComponents;
+		const uint32_t queryID = ComponentQueryRegistry::GetQueryID<T>();
+		if (componentTypeIndexVersion != ComponentQueryRegistry::GetVersion())
+		{
+			RebuildComponentTypeIndex();
+		}
 
-		for (auto& componentPair : componentMap)
+		if ((componentTypeMask & (1ull << queryID)) == 0)
 		{
-			T* outComponent = dynamic_cast<T*>(componentPair.second);
-			if (outComponent)
-			{
-				outComponents.emplace_back(outComponent);
-			}
+			return ComponentTypeView<T>();
 		}
 
-		return outComponents;
+		const auto [first, last] = FindComponentTypeRange(queryID);
+		return ComponentTypeView<T>(first, last);
 	}
 
 	template <typename T>
 	T* GetFirstComponentOfTypeAllowNull()
 	{
-		std::vector<T*> componentsOfType = GetComponentsOfType<T>();
+		ComponentTypeView<T> componentsOfType = GetComponentsOfType<T>();
 		if (!componentsOfType.empty())
 		{
 			return componentsOfType.front();
@@ -157,10 +183,16 @@ public:
 		return nullptr;
 	}
 
+	template <typename T>
+	bool HasComponentOfType()
+	{
+		return !GetComponentsOfType<T>().empty();
+	}
+
 	template <typename T>
 	T* GetComponent(std::string componentName)
 	{
-		auto componentIt = componentMap.find(componentName);
+		auto componentIt = FindComponentEntry(Symbol::Find(componentName));
 		if (componentIt != componentMap.end())
 		{
 			return static_cast<T*>(componentIt->second);
@@ -175,7 +207,7 @@ public:
 	void ResetOwnerUIDToComponents();
 
 	UID GetUID() { return uid; }
-	void SetUID(const UID uid_) { uid = uid_; }
+	void SetUID(const UID uid_);
 
 	int GetSystemIndex() { return actorSystemIndex; }
 	void SetSystemIndex(const int index) { actorSystemIndex = index; }
@@ -183,28 +215,59 @@ public:
 	IActorSystem* GetActorSystem() { return actorSystem; }
 	void SetActorSystem(IActorSystem* system) { actorSystem = system; }
 
+	//Slot and generation issued by the ActorSystem. Use ActorHandle<> instead of reading these directly.
+	uint32_t GetHandleSlot() { return handleSlot; }
+	uint32_t GetHandleGeneration() { return handleGeneration; }
+	void SetHandle(const uint32_t slot, const uint32_t generation) { handleSlot = slot; handleGeneration = generation; }
+
 	//Helper for whether the Actor's mesh can be occluded by player and camera.
 	//This function is needed because player to camera transparency can mess with previously hit actors
 	//for example if they're Destroy()ed in battle or by whatever else.
 	bool CanBeTransparentlyOccluded();
 
-	bool HasTag(const std::string& tag);
-	void AddTag(const std::string& tag) { tags.insert(tag); }
+	bool HasTag(Symbol tag);
+	bool HasTag(const std::string& tag) { return HasTag(Symbol::Find(tag)); }
+	void AddTag(Symbol tag);
+	void AddTag(const std::string& tag) { AddTag(Symbol(tag)); }
 
 	void SetMeshesToDynamicPhysicsState();
 	void SetMeshesToStaticPhysicsState();
 
+private:
+	using ComponentEntry = std::pair<Symbol, Component*>;
+
+	//Linear scan comparing symbol IDs, actors only have a handful of components.
+	std::vector<ComponentEntry>::iterator FindComponentEntry(Symbol componentName);
+
+	void AddToComponentTypeIndex(Component* component);
+	void RemoveFromComponentTypeIndex(Component* component);
+	void RebuildComponentTypeIndex();
+	std::pair<const TypedComponentEntry*, const TypedComponentEntry*> FindComponentTypeRange(uint32_t queryID);
+
+	//Bit per ComponentQueryRegistry query type this actor has at least one component of, and
+	//(query type, component) entries sorted by query type then component name.
+	uint64_t componentTypeMask = 0;
+	std::vector<TypedComponentEntry> componentsByType;
+	uint32_t componentTypeIndexVersion = 0;
+
 protected:
 	Actor* parent = nullptr;
 	std::vector<Actor*> children;
-	std::set<std::string> tags;
-	std::map<std::string, Component*> componentMap;
+	std::vector<Symbol> tags; //Sorted
+
+	//Flat map of component name to component, kept in component name order.
+	std::vector<ComponentEntry> componentMap;
 	SpatialComponent* rootComponent = nullptr;
 	IActorSystem* actorSystem = nullptr;
 	std::string name;
 	UID uid = GenerateUID();
 	int actorSystemIndex = -1;
+	float accumulatedTickTime = 0.f;
+	uint32_t handleSlot = 0;
+	uint32_t handleGeneration = 0;
 	bool active = true;
 	bool visible = true;
 	bool tickEnabled = true;
+	bool pendingDestroy = false;
+	bool saveDirty = false;
 };
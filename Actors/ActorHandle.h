@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include "IActorSystem.h"
+
+class Actor;
+
+//Weak reference to an Actor, issued by the actor's ActorSystem.
+//Get() returns nullptr once the actor has been removed instead of dangling like a raw pointer.
+template <typename T = Actor>
+class ActorHandle
+{
+public:
+	ActorHandle() {}
+	ActorHandle(T* actor) { Set(actor); }
+
+	void Set(T* actor)
+	{
+		if (actor == nullptr)
+		{
+			Reset();
+			return;
+		}
+
+		system = actor->GetActorSystem();
+		slot = actor->GetHandleSlot();
+		generation = actor->GetHandleGeneration();
+	}
+
+	T* Get() const
+	{
+		if (system == nullptr)
+		{
+			return nullptr;
+		}
+
+		return static_cast<T*>(system->ResolveHandle(slot, generation));
+	}
+
+	void Reset()
+	{
+		system = nullptr;
+		slot = 0;
+		generation = 0;
+	}
+
+	T* operator->() const { return Get(); }
+	explicit operator bool() const { return Get() != nullptr; }
+
+	bool operator==(const ActorHandle& other) const
+	{
+		return system == other.system && slot == other.slot && generation == other.generation;
+	}
+
+private:
+	IActorSystem* system = nullptr;
+	uint32_t slot = 0;
+	uint32_t generation = 0;
+};
@@ -0,0 +1,53 @@
+#include "vpch.h"
+#include "ActorNameIndex.h"
+#include <unordered_map>
+#include "Actor.h"
+
+static std::unordered_map<std::string, Actor*> actorsByName;
+
+void ActorNameIndex::Add(Actor* actor, bool replaceExisting)
+{
+	if (replaceExisting)
+	{
+		actorsByName.insert_or_assign(actor->GetName(), actor);
+		return;
+	}
+
+	//First actor to claim a name keeps it, same as SetName()'s collision check.
+	actorsByName.emplace(actor->GetName(), actor);
+}
+
+void ActorNameIndex::Remove(Actor* actor)
+{
+	auto actorIt = actorsByName.find(actor->GetName());
+	if (actorIt != actorsByName.end() && actorIt->second == actor)
+	{
+		actorsByName.erase(actorIt);
+	}
+}
+
+Actor* ActorNameIndex::Find(const std::string& name)
+{
+	auto actorIt = actorsByName.find(name);
+	if (actorIt == actorsByName.end())
+	{
+		return nullptr;
+	}
+
+	return actorIt->second;
+}
+
+bool ActorNameIndex::Contains(const std::string& name)
+{
+	return actorsByName.find(name) != actorsByName.end();
+}
+
+size_t ActorNameIndex::GetNumActors()
+{
+	return actorsByName.size();
+}
+
+void ActorNameIndex::Reserve(size_t count)
+{
+	actorsByName.reserve(actorsByName.size() + count);
+}
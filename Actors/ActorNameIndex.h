@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+
+class Actor;
+
+//Hashed lookup of actors by name across every ActorSystem. Actor names are unique in the world,
+//so per-system lookups go through here too and check the returned actor's system.
+//Kept up to date by Actor::SetName()/SimpleSetName() and ActorSystem Remove/Cleanup/Deserialise.
+namespace ActorNameIndex
+{
+	//First actor to claim a name keeps it, unless replaceExisting. Names read in from world files and saves
+	//replace whatever holds them, that can be another actor's generated name whose own record hasn't been read yet.
+	void Add(Actor* actor, bool replaceExisting = false);
+
+	//Only removes the entry if it maps to the passed in actor.
+	void Remove(Actor* actor);
+
+	Actor* Find(const std::string& name);
+	bool Contains(const std::string& name);
+
+	size_t GetNumActors();
+
+	//Sizes the table for count more actors before a batch of adds.
+	void Reserve(size_t count);
+};
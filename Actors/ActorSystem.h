@@ -1,15 +1,27 @@
 #pragma once
 
 #include <vector>
+#include <array>
 #include <memory>
+#include <atomic>
 #include "IActorSystem.h"
 #include "Actor.h"
 #include "ActorSystemCache.h"
+#include "ActorNameIndex.h"
 #include "Core/Serialiser.h"
 #include "Components/Component.h"
+#include "Components/SpatialComponent.h"
 #include "Editor/Editor.h"
 #include "Core/World.h"
+#include "Core/Core.h"
 #include "Core/VString.h"
+#include "Core/HandleTable.h"
+#include "Core/PropsSchema.h"
+#include "Core/JobSystem.h"
+#include "Core/SystemProfiler.h"
+#include "Core/UIDIndex.h"
+#include "Core/WorldDelta.h"
+#include "Core/WorldCache.h"
 
 //Actor systems were based on UE4 talk from Rare
 //Ref: https://www.unrealengine.com/en-US/events/unreal-fest-europe-2019/aggregating-ticks-to-manage-scale-in-sea-of-thieves
@@ -30,36 +42,51 @@ public:
 	T* Add(Transform transform = Transform())
 	{
 		actors.emplace_back(std::make_unique<T>());
-		auto& actor = actors.back();
+		T* actor = actors.back().get();
+		InitAddedActor(*actor, transform);
+		return actor;
+	}
 
-		actor->SetActorSystem(this);
-		actor->SetSystemIndex(actors.size() - 1);
-		actor->SetTransform(transform);
+	//Adds count actors with storage, handles and lookups reserved up front.
+	//transforms is either empty (default Transform) or has one transform per actor.
+	std::vector<T*> AddBatch(size_t count, const std::vector<Transform>& transforms = {})
+	{
+		assert(transforms.empty() || transforms.size() == count);
 
-		//AddActorToWorld() call is in SetName()
-		if (!actor->SetName(this->name + std::to_string(actor->GetSystemIndex())))
+		actors.reserve(actors.size() + count);
+		handles.Reserve(count);
+		ActorNameIndex::Reserve(count);
+		UIDIndex::ReserveActors(count);
+
+		std::vector<T*> addedActors;
+		addedActors.reserve(count);
+
+		for (size_t i = 0; i < count; i++)
 		{
-			auto uid = (unsigned int)GenerateUID(); //std::to_string goes bananas with UID
-			actor->SimpleSetName(this->name + std::to_string(uid));
+			actors.emplace_back(std::make_unique<T>());
+			T* actor = actors.back().get();
+			InitAddedActor(*actor, transforms.empty() ? Transform() : transforms[i]);
+			addedActors.emplace_back(actor);
 		}
 
-		return actor.get();
+		return addedActors;
 	}
 
+	//Removes the actor straight away. Use QueueRemove() (Destroy()) during gameplay.
 	void Remove(int index)
 	{
-		auto components = actors[index]->GetAllComponents();
-		for (int i = 0; i < components.size(); i++)
+		PROFILE_SYSTEM(name, Remove, 1);
+
+		if (actors[index]->IsPendingDestroy())
 		{
-			Component* component = components[i];
-			actors[index]->RemoveComponent(component);
-			component->Remove();
+			numPendingRemoves--;
 		}
 
 		std::swap(actors[index], actors.back());
 		actors[index]->SetSystemIndex(index);
+		handles.SetIndex(actors[index]->GetHandleSlot(), index);
 
-		World::RemoveActorFromWorld(actors.back().get());
+		ReleaseActor(*actors.back());
 		actors.pop_back();
 
 		//@Todo: Release/NoEditor #ifdef here later.
@@ -67,34 +94,168 @@ public:
 		editor->ClearProperties();
 	}
 
+	//Marks the actor for removal on the next flush. The actor is deactivated but stays in the system until then,
+	//so it's safe to call mid iteration (e.g. an actor destroying itself or another in Tick()).
+	//Outside of gameplay (editor) the actor is removed immediately.
+	void QueueRemove(int index)
+	{
+		T* actor = actors[index].get();
+		if (actor->IsPendingDestroy())
+		{
+			return;
+		}
+
+		if (!Core::gameplayOn)
+		{
+			Remove(index);
+			return;
+		}
+
+		actor->MarkPendingDestroy();
+		WorldDelta::OnActorRemoved(actor);
+
+		if (numPendingRemoves++ == 0)
+		{
+			ActorSystemCache::Get().AddSystemWithPendingRemoves(this);
+		}
+	}
+
+	//Removes all queued actors in one stable compaction pass. Editor notification is left to
+	//ActorSystemCache::FlushPendingRemoves() so it happens once for every system flushed.
+	virtual void FlushPendingRemoves() override
+	{
+		if (numPendingRemoves == 0)
+		{
+			return;
+		}
+
+		PROFILE_SYSTEM(name, Remove, numPendingRemoves.load());
+
+		uint32_t numRemoved = 0;
+		size_t liveCount = 0;
+
+		for (size_t i = 0; i < actors.size(); i++)
+		{
+			if (actors[i]->IsPendingDestroy())
+			{
+				ReleaseActor(*actors[i]);
+				actors[i].reset();
+				numRemoved++;
+				continue;
+			}
+
+			if (liveCount != i)
+			{
+				actors[liveCount] = std::move(actors[i]);
+				actors[liveCount]->SetSystemIndex(liveCount);
+				handles.SetIndex(actors[liveCount]->GetHandleSlot(), liveCount);
+			}
+
+			liveCount++;
+		}
+
+		actors.resize(liveCount);
+
+		//Releasing components can queue more removes on actors already passed over.
+		numPendingRemoves -= numRemoved;
+		if (numPendingRemoves > 0)
+		{
+			ActorSystemCache::Get().AddSystemWithPendingRemoves(this);
+		}
+	}
+
 	virtual void RemoveInterfaceActor(Actor* actor) override
 	{
-		Remove(actor->GetSystemIndex());
+		QueueRemove(actor->GetSystemIndex());
 	}
 
 	void RemoveAllActors()
 	{
-		for (int i = actors.size() - 1; i > -1; i--)
+		PROFILE_SYSTEM(name, Remove, actors.size());
+
+		for (auto& actor : actors)
 		{
-			Remove(actors[i]->GetSystemIndex());
+			ReleaseActor(*actor);
 		}
+
+		actors.clear();
+		numPendingRemoves = 0;
+
+		editor->UpdateWorldList();
+		editor->ClearProperties();
 	}
 
 	virtual void Tick(float deltaTime) override
 	{
-		//Has to be an index based forloop here instead of a range forloop because 
-		//actors can be destroyed in-game and its pointer popped off its actorsystem.
-		for (int i = 0; i < actors.size(); i++)
+		PROFILE_SYSTEM(name, Tick, actors.size());
+
+		const uint32_t frameIndex = tickFrameIndex++;
+
+		if constexpr (ParallelTickSafe<T>)
+		{
+			std::atomic<uint32_t> ticked = 0;
+			std::atomic<uint32_t> skipped = 0;
+			std::atomic<uint32_t> asleep = 0;
+
+			//Destroy() only queues the remove, so ranges over the vector are stable.
+			JobSystem::ParallelFor(static_cast<uint32_t>(actors.size()), parallelTickGrainSize, [&](uint32_t begin, uint32_t end) {
+				ActorTickStats rangeStats;
+				for (uint32_t i = begin; i < end; i++)
+				{
+					if (actors[i]->IsTickEnabled() && actors[i]->IsActive() && !actors[i]->IsPendingDestroy())
+					{
+						TickActor(*actors[i], deltaTime, frameIndex, rangeStats);
+					}
+				}
+
+				ticked += rangeStats.ticked;
+				skipped += rangeStats.skipped;
+				asleep += rangeStats.asleep;
+			});
+
+			tickStats.ticked = ticked;
+			tickStats.skipped = skipped;
+			tickStats.asleep = asleep;
+		}
+		else
 		{
-			if (actors[i]->IsTickEnabled() && actors[i]->IsActive())
+			ActorTickStats stats;
+
+			//Has to be an index based forloop here instead of a range forloop because 
+			//actors can be destroyed in-game and its pointer popped off its actorsystem.
+			for (int i = 0; i < actors.size(); i++)
 			{
-				actors[i]->Tick(deltaTime);
+				if (actors[i]->IsTickEnabled() && actors[i]->IsActive() && !actors[i]->IsPendingDestroy())
+				{
+					TickActor(*actors[i], deltaTime, frameIndex, stats);
+				}
 			}
+
+			tickStats = stats;
 		}
 	}
 
+	virtual SystemAccess GetAccess() override
+	{
+		if constexpr (DeclaresSystemAccess<T>)
+		{
+			return T::systemAccess;
+		}
+		else
+		{
+			return SystemAccess();
+		}
+	}
+
+	virtual ActorTickStats GetTickStats() override
+	{
+		return tickStats;
+	}
+
 	void Init() override
 	{
+		PROFILE_SYSTEM(name, Init, actors.size());
+
 		for (auto& actor : actors)
 		{
 			actor->Create();
@@ -103,6 +264,8 @@ public:
 
 	void PostInit() override
 	{
+		PROFILE_SYSTEM(name, Init, actors.size());
+
 		for (auto& actor : actors)
 		{
 			actor->PostCreate();
@@ -143,8 +306,20 @@ public:
 		return actors.size();
 	}
 
+	virtual Actor* GetActorByIndex(uint32_t index) override
+	{
+		return actors[index].get();
+	}
+
+	virtual bool IsActorPendingDestroy(uint32_t index) override
+	{
+		return actors[index]->IsPendingDestroy();
+	}
+
 	virtual void Serialise(Serialiser& s) override
 	{
+		PROFILE_SYSTEM(name, Serialise, actors.size());
+
 		s.WriteLine(VString::stows(GetName())); //Use actorsystem name to create again from ActorSystemCache on Deserialise
 		s.WriteLine(actors.size()); //Write out num of actors to load the same amount on Deserialise
 
@@ -159,10 +334,23 @@ public:
 
 	virtual void SerialiseBinary(BinarySerialiser& s) override
 	{
+		PROFILE_SYSTEM(name, Serialise, actors.size());
+
 		s.WriteString(GetName());
 		size_t numActors = actors.size();
 		s.Write(&numActors);
 
+		const bool packedRecords = GetPropsSchema().IsRecordable();
+		s.Write(&packedRecords);
+
+		if (packedRecords)
+		{
+			PackedRecords records;
+			WriteRecords(records);
+			s.WriteString(records.GetBytes());
+			return;
+		}
+
 		for (auto& actor : actors)
 		{
 			auto props = actor->GetProps();
@@ -172,41 +360,145 @@ public:
 
 	virtual void Deserialise(Deserialiser& d) override
 	{
+		PROFILE_SYSTEM(name, Deserialise, actors.size());
+
 		for (auto& actor : actors)
 		{
+			//Name and UID are properties, reindex once they've been read in.
+			ActorNameIndex::Remove(actor.get());
+			UIDIndex::RemoveActor(actor.get());
 			auto props = actor->GetProps();
 			d.Deserialise(props);
+			ActorNameIndex::Add(actor.get(), true);
+			UIDIndex::AddActor(actor.get());
 		}
 	}
 
 	virtual void DeserialiseBinary(BinaryDeserialiser& d) override
 	{
+		PROFILE_SYSTEM(name, Deserialise, actors.size());
+
+		bool packedRecords = false;
+		d.Read(&packedRecords);
+
+		if (packedRecords)
+		{
+			std::string recordBytes;
+			d.ReadString(recordBytes);
+			PackedRecords records(std::move(recordBytes));
+			ReadRecords(records, 0);
+			return;
+		}
+
 		for (auto& actor : actors)
 		{
+			//Name and UID are properties, reindex once they've been read in.
+			ActorNameIndex::Remove(actor.get());
+			UIDIndex::RemoveActor(actor.get());
 			auto props = actor->GetProps();
 			d.Deserialise(props);
+			ActorNameIndex::Add(actor.get(), true);
+			UIDIndex::AddActor(actor.get());
 		}
 	}
 
-	virtual Actor* FindActorByName(std::string actorName) override
+	virtual const PropsSchema& GetPropsSchema() override
+	{
+		BuildPropsSchema();
+		return propsSchema;
+	}
+
+	virtual void WriteRecords(PackedRecords& records) override
 	{
+		BuildPropsSchema();
+		assert(propsSchema.IsRecordable());
+
+		propsSchema.WriteHeader(records);
+
 		for (auto& actor : actors)
 		{
-			if (actor->GetName() == actorName)
-			{
-				return (Actor*)actor.get();
-			}
+			WriteRecord(records, *actor);
+		}
+	}
+
+	virtual void WriteRecords(PackedRecords& records, const std::vector<Actor*>& sources) override
+	{
+		BuildPropsSchema();
+		assert(propsSchema.IsRecordable());
+
+		propsSchema.WriteHeader(records);
+
+		for (Actor* source : sources)
+		{
+			assert(source->GetActorSystem() == this);
+			WriteRecord(records, *static_cast<T*>(source));
+		}
+	}
+
+	virtual void WriteRecord(PackedRecords& records, Actor* source) override
+	{
+		BuildPropsSchema();
+		assert(source->GetActorSystem() == this);
+		WriteRecord(records, *static_cast<T*>(source));
+	}
+
+	virtual void ReadRecords(PackedRecords& records, uint32_t firstIndex) override
+	{
+		BuildPropsSchema();
+		const PropsSchema::FileLayout layout = propsSchema.ReadHeader(records);
+
+		for (size_t i = firstIndex; i < actors.size(); i++)
+		{
+			ReadRecord(records, *actors[i], layout);
+		}
+	}
+
+	virtual void ReadRecords(PackedRecords& records, const std::vector<Actor*>& targets) override
+	{
+		BuildPropsSchema();
+		const PropsSchema::FileLayout layout = propsSchema.ReadHeader(records);
+
+		for (Actor* target : targets)
+		{
+			assert(target->GetActorSystem() == this);
+			ReadRecord(records, *static_cast<T*>(target), layout);
+		}
+	}
+
+	virtual Actor* FindActorByName(std::string actorName) override
+	{
+		Actor* actor = ActorNameIndex::Find(actorName);
+		if (actor && actor->GetActorSystem() == this)
+		{
+			return actor;
 		}
 
 		return nullptr;
 	}
 
+	virtual Actor* ResolveHandle(uint32_t slot, uint32_t generation) override
+	{
+		const int index = handles.Resolve(slot, generation);
+		if (index < 0)
+		{
+			return nullptr;
+		}
+
+		return actors[index].get();
+	}
+
 	virtual Actor* SpawnActor(const Transform& transform) override
 	{
 		auto actor = static_cast<Actor*>(Add(transform));
 		return actor;
 	}
 
+	virtual std::vector<Actor*> SpawnBatch(size_t count, const std::vector<Transform>& transforms) override
+	{
+		std::vector<T*> addedActors = AddBatch(count, transforms);
+		return std::vector<Actor*>(addedActors.begin(), addedActors.end());
+	}
+
 	virtual std::vector<Actor*> GetActorsAsBaseClass() override
 	{
 		std::vector<Actor*> outActors;
@@ -219,12 +511,211 @@ public:
 
 	virtual void Cleanup() override
 	{
+		for (auto& actor : actors)
+		{
+			ActorNameIndex::Remove(actor.get());
+			UIDIndex::RemoveActor(actor.get());
+		}
+
+		handles.ReleaseAll();
 		actors.clear();
+		nextNameSuffix = 0;
+		numPendingRemoves = 0;
+	}
+
+	virtual std::unique_ptr<DetachedSystem> Detach() override
+	{
+		assert(numPendingRemoves == 0);
+
+		for (auto& actor : actors)
+		{
+			World::RemoveActorFromWorld(actor.get());
+			ActorNameIndex::Remove(actor.get());
+			UIDIndex::RemoveActor(actor.get());
+		}
+
+		auto detached = std::make_unique<DetachedActors>();
+		detached->actors = std::move(actors);
+		detached->handles = std::move(handles);
+		detached->nextNameSuffix = nextNameSuffix;
+
+		actors.clear();
+		//Generations are unique across tables, stale handles from the detached world won't resolve to new objects.
+		handles = HandleTable();
+		nextNameSuffix = 0;
+
+		return detached;
+	}
+
+	virtual void Reattach(std::unique_ptr<DetachedSystem> detachedSystem) override
+	{
+		assert(actors.empty());
+
+		auto& detached = static_cast<DetachedActors&>(*detachedSystem);
+		actors = std::move(detached.actors);
+		handles = std::move(detached.handles);
+		nextNameSuffix = detached.nextNameSuffix;
+
+		for (auto& actor : actors)
+		{
+			ActorNameIndex::Add(actor.get());
+			UIDIndex::AddActor(actor.get());
+			World::AddActorToWorld(actor.get());
+		}
 	}
 
 private:
+	struct DetachedActors : DetachedSystem
+	{
+		std::vector<std::unique_ptr<T>> actors;
+		HandleTable handles;
+		uint32_t nextNameSuffix = 0;
+
+		virtual size_t GetMemorySize() const override { return actors.size() * sizeof(T); }
+	};
+
+	//Shared setup for Add() and AddBatch() once the actor is at the back of the vector.
+	void InitAddedActor(T& actor, const Transform& transform)
+	{
+		actor.SetActorSystem(this);
+		actor.SetSystemIndex(actors.size() - 1);
+		actor.SetTransform(transform);
+
+		const uint32_t handleSlot = handles.Issue(actor.GetSystemIndex());
+		actor.SetHandle(handleSlot, handles.GetGeneration(handleSlot));
+
+		//Components added in T's constructor were given an owner before the actor had a handle.
+		for (Component* component : actor.GetAllComponents())
+		{
+			component->SetOwner(&actor);
+		}
+
+		UIDIndex::AddActor(&actor);
+
+		//AddActorToWorld() call is in SetName()
+		actor.SetName(GenerateUniqueActorName(actor.GetSystemIndex()));
+
+		WorldDelta::OnActorSpawned(&actor);
+	}
+
+	//Everything Remove() needs besides taking the actor out of the vector.
+	void ReleaseActor(T& actor)
+	{
+		for (Component* component : actor.GetAllComponents())
+		{
+			actor.RemoveComponent(component);
+			component->Remove();
+		}
+
+		handles.Release(actor.GetHandleSlot());
+
+		WorldDelta::OnActorRemoved(&actor);
+		World::RemoveActorFromWorld(&actor);
+		ActorNameIndex::Remove(&actor);
+		UIDIndex::RemoveActor(&actor);
+	}
+
+	//Default names are the system name plus a suffix. The suffix only moves forward so a collision
+	//costs another hash lookup, not a rescan of the world.
+	std::string GenerateUniqueActorName(uint32_t preferredSuffix)
+	{
+		nextNameSuffix = std::max(nextNameSuffix, preferredSuffix);
+
+		std::string newName = name + std::to_string(nextNameSuffix++);
+		while (ActorNameIndex::Contains(newName))
+		{
+			newName = name + std::to_string(nextNameSuffix++);
+		}
+
+		return newName;
+	}
+
+	//Actor props point into the actor and its root component's transform.
+	static std::array<void*, 2> GetPropsSchemaBases(T& actor)
+	{
+		return { &actor, &actor.GetRootComponent() };
+	}
+
+	void WriteRecord(PackedRecords& records, T& actor)
+	{
+		if (propsSchema.IsValid())
+		{
+			propsSchema.WriteRecord(records, GetPropsSchemaBases(actor).data());
+		}
+		else
+		{
+			auto props = actor.GetProps();
+			propsSchema.WriteRecordFromProps(records, props);
+		}
+	}
+
+	void ReadRecord(PackedRecords& records, T& actor, const PropsSchema::FileLayout& layout)
+	{
+		//Name and UID are in the records, reindex once they've been read in.
+		ActorNameIndex::Remove(&actor);
+		UIDIndex::RemoveActor(&actor);
+
+		if (propsSchema.IsValid())
+		{
+			propsSchema.ReadRecord(records, GetPropsSchemaBases(actor).data(), layout);
+		}
+		else
+		{
+			auto props = actor.GetProps();
+			PropsSchema::ReadRecordIntoProps(records, layout, props);
+		}
+
+		ActorNameIndex::Add(&actor, true);
+		UIDIndex::AddActor(&actor);
+	}
+
+	//Every actor of T has the same props layout, so the first one's GetProps() stands in for all of them.
+	void BuildPropsSchema()
+	{
+		if (propsSchema.IsBuilt() || actors.empty())
+		{
+			return;
+		}
+
+		T& actor = *actors.front();
+		auto props = actor.GetProps();
+		const PropsSchema::Base bases[] = {
+			{ &actor, sizeof(T) },
+			{ &actor.GetRootComponent(), sizeof(SpatialComponent) },
+		};
+		propsSchema.Build(props, bases, std::size(bases));
+	}
+
+	static void TickActor(T& actor, float deltaTime, uint32_t frameIndex, ActorTickStats& stats)
+	{
+		float actorDeltaTime = deltaTime;
+		switch (actor.ScheduleTick(deltaTime, frameIndex, actorDeltaTime))
+		{
+		case TickDecision::Tick:
+			actor.Tick(actorDeltaTime);
+			stats.ticked++;
+			break;
+		case TickDecision::Skip:
+			stats.skipped++;
+			break;
+		case TickDecision::Sleep:
+			stats.asleep++;
+			break;
+		}
+	}
+
+	//Number of actors handed to each job when T is marked with PARALLEL_TICK.
+	static constexpr uint32_t parallelTickGrainSize = 32;
+
 	std::vector<std::unique_ptr<T>> actors;
+	HandleTable handles;
+	PropsSchema propsSchema;
+	ActorTickStats tickStats;
+	uint32_t tickFrameIndex = 0;
+	uint32_t nextNameSuffix = 0;
+	//PARALLEL_TICK actors and systems in a parallel stage can Destroy() from several threads at once.
+	std::atomic<uint32_t> numPendingRemoves = 0;
 };
 
 #define ACTOR_SYSTEM(type) inline static ActorSystem<type> system; \
-virtual void Destroy() override { system.Remove(GetSystemIndex()); } \
+virtual void Destroy() override { system.QueueRemove(GetSystemIndex()); } \
@@ -1,11 +1,13 @@
 #include "vpch.h"
 #include "ActorSystemCache.h"
 #include "IActorSystem.h"
+#include "Editor/Editor.h"
 
 void ActorSystemCache::AddSystem(std::type_index type, IActorSystem* actorSystem)
 {
 	typeToSystemMap.emplace(type, actorSystem);
 	nameToSystemMap.emplace(actorSystem->GetName(), actorSystem);
+	systemList.emplace_back(actorSystem);
 }
 
 IActorSystem* ActorSystemCache::GetSystem(std::string systemName)
@@ -43,3 +45,33 @@ std::vector<std::string> ActorSystemCache::GetAllActorSystemNames()
 	}
 	return names;
 }
+
+void ActorSystemCache::AddSystemWithPendingRemoves(IActorSystem* actorSystem)
+{
+	std::lock_guard<std::mutex> lock(pendingRemovesMutex);
+	systemsWithPendingRemoves.emplace_back(actorSystem);
+}
+
+void ActorSystemCache::FlushPendingRemoves()
+{
+	if (systemsWithPendingRemoves.empty())
+	{
+		return;
+	}
+
+	//Removing an actor's components can queue more removes, keep going until nothing is left.
+	while (!systemsWithPendingRemoves.empty())
+	{
+		std::vector<IActorSystem*> systems;
+		systems.swap(systemsWithPendingRemoves);
+
+		for (IActorSystem* actorSystem : systems)
+		{
+			actorSystem->FlushPendingRemoves();
+		}
+	}
+
+	//@Todo: Release/NoEditor #ifdef here later.
+	editor->UpdateWorldList();
+	editor->ClearProperties();
+}
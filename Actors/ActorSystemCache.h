@@ -1,9 +1,11 @@
 #pragma once
 
+#include <mutex>
 #include <typeindex>
 #include <unordered_map>
 #include <optional>
 #include <string>
+#include <vector>
 
 class IActorSystem;
 
@@ -21,9 +23,23 @@ public:
 	IActorSystem* GetSystem(std::type_index actorType);
 
 	std::vector<IActorSystem*> GetAllSystems();
+
+	//Systems in the order they were added, without building a new vector.
+	const std::vector<IActorSystem*>& GetSystemList() { return systemList; }
 	std::vector<std::string> GetAllActorSystemNames();
 
+	//Called by ActorSystem::QueueRemove() for the first actor queued since the system's last flush.
+	//Safe to call from parallel ticks.
+	void AddSystemWithPendingRemoves(IActorSystem* actorSystem);
+
+	//Removes all queued actors across every system with one editor update.
+	//SystemScheduler runs this once a frame after every system has ticked.
+	void FlushPendingRemoves();
+
 private:
+	std::vector<IActorSystem*> systemList;
+	std::mutex pendingRemovesMutex;
+	std::vector<IActorSystem*> systemsWithPendingRemoves;
 	std::unordered_map<std::optional<std::type_index>, IActorSystem*> typeToSystemMap;
 	std::map<std::string, IActorSystem*> nameToSystemMap;
 };
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include "IActorSystem.h"
+#include "ActorSystemCache.h"
+
+class Actor;
+
+//Non-owning range over every live actor that is a T (derived types included, e.g. Player and
+//AttackUnit for PlayerUnit). Walks the matching ActorSystems' own actor vectors, so nothing is allocated
+//per query and spawns/destroys show up without any bookkeeping. Actors pending destruction are skipped.
+template <typename T>
+class ActorTypeView
+{
+public:
+	class Iterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = T*;
+		using difference_type = std::ptrdiff_t;
+		using pointer = T**;
+		using reference = T*;
+
+		Iterator(const std::vector<IActorSystem*>* systems_, size_t systemIndex_) :
+			systems(systems_), systemIndex(systemIndex_)
+		{
+			SkipToLiveActor();
+		}
+
+		T* operator*() const { return static_cast<T*>((*systems)[systemIndex]->GetActorByIndex(actorIndex)); }
+
+		Iterator& operator++()
+		{
+			actorIndex++;
+			SkipToLiveActor();
+			return *this;
+		}
+
+		bool operator==(const Iterator& other) const { return systemIndex == other.systemIndex && actorIndex == other.actorIndex; }
+		bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+	private:
+		void SkipToLiveActor()
+		{
+			while (systemIndex < systems->size())
+			{
+				IActorSystem* actorSystem = (*systems)[systemIndex];
+				if (actorIndex < actorSystem->GetNumActors())
+				{
+					if (!actorSystem->IsActorPendingDestroy(actorIndex))
+					{
+						return;
+					}
+
+					actorIndex++;
+					continue;
+				}
+
+				systemIndex++;
+				actorIndex = 0;
+			}
+		}
+
+		const std::vector<IActorSystem*>* systems;
+		size_t systemIndex = 0;
+		uint32_t actorIndex = 0;
+	};
+
+	ActorTypeView(const std::vector<IActorSystem*>& systems_) : systems(&systems_) {}
+
+	Iterator begin() const { return Iterator(systems, 0); }
+	Iterator end() const { return Iterator(systems, systems->size()); }
+
+	bool empty() const { return begin() == end(); }
+
+	//Counts by walking the range.
+	size_t size() const { return static_cast<size_t>(std::distance(begin(), end())); }
+
+private:
+	const std::vector<IActorSystem*>* systems;
+};
+
+//World wide actor queries by type, replacing GetAllActorsOfTypeInWorld<T>() scans.
+class ActorQueryRegistry
+{
+public:
+	template <typename T>
+	static ActorTypeView<T> GetActorsOfType()
+	{
+		static QueryType queryType([](Actor* actor) { return dynamic_cast<T*>(actor) != nullptr; });
+		queryType.Refresh();
+		return ActorTypeView<T>(queryType.matchingSystems);
+	}
+
+private:
+	//Which ActorSystems hold a query's type. Each system is checked once with a dynamic_cast
+	//on one of its actors, so systems stay unchecked until they've spawned something.
+	struct QueryType
+	{
+		using IsAFunc = bool(*)(Actor*);
+
+		QueryType(IsAFunc isA_) : isA(isA_) {}
+
+		void Refresh()
+		{
+			const std::vector<IActorSystem*>& allSystems = ActorSystemCache::Get().GetSystemList();
+			for (; numSystemsSeen < allSystems.size(); numSystemsSeen++)
+			{
+				uncheckedSystems.emplace_back(allSystems[numSystemsSeen]);
+			}
+
+			for (size_t i = 0; i < uncheckedSystems.size();)
+			{
+				IActorSystem* actorSystem = uncheckedSystems[i];
+				if (actorSystem->GetNumActors() == 0)
+				{
+					i++;
+					continue;
+				}
+
+				if (isA(actorSystem->GetActorByIndex(0)))
+				{
+					matchingSystems.emplace_back(actorSystem);
+				}
+
+				uncheckedSystems[i] = uncheckedSystems.back();
+				uncheckedSystems.pop_back();
+			}
+		}
+
+		IsAFunc isA;
+		std::vector<IActorSystem*> matchingSystems;
+		std::vector<IActorSystem*> uncheckedSystems;
+		size_t numSystemsSeen = 0;
+	};
+};
@@ -8,7 +8,7 @@
 #include "Gameplay/GameInstance.h"
 #include "Gameplay/BattleSystem.h"
 #include "Core/Input.h"
-#include "Core/FileSystem.h"
+#include "Core/AsyncWorldLoader.h"
 #include "UI/Game/InteractWidget.h"
 #include "UI/Game/PopupWidget.h"
 #include "UI/ScreenFadeWidget.h"
@@ -39,6 +39,11 @@ void EntranceTrigger::Start()
 
     trigger->SetTargetAsPlayer();
 
+    //Full rate once the player is near enough to step into the trigger. Out to the preload radius
+    //a reduced rate is plenty to notice the player walking up and prefetch the level.
+    tickSchedule.lodNearDistance = trigger->GetWorldBoundingRadius() + 1.f;
+    tickSchedule.lodSleepDistance = std::max(tickSchedule.lodNearDistance, preloadRadius);
+
     if (!conditionComponent->condition.empty())
     {
         interactWidget->interactText = lockedText;
@@ -50,6 +55,15 @@ void EntranceTrigger::Tick(float deltaTime)
 {
     XMVECTOR targetPos = trigger->targetActor->GetPositionV();
 
+    if (isEntranceActive && !isEntranceLocked && !levelToMoveTo.empty() && !entranceInteractedWith)
+    {
+        const float targetDistance = XMVectorGetX(XMVector3Length(targetPos - GetPositionV()));
+        if (targetDistance <= preloadRadius)
+        {
+            AsyncWorldLoader::Prefetch(levelToMoveTo);
+        }
+    }
+
     if (trigger->ContainsTarget() && isEntranceActive && !battleSystem.isBattleActive && !entranceInteractedWith)
     {
         interactWidget->AddToViewport();
@@ -84,12 +98,14 @@ void EntranceTrigger::Tick(float deltaTime)
 
             if (GameInstance::useGameSaves)
             {
-                FileSystem::SerialiseAllSystems();
+                GameUtils::SaveGameWorldState();
             }
 
             GameUtils::PlayAudioOneShot("door.wav");
 
+            //The next world loads in the background during the fade and is swapped in once it's done.
             GameUtils::levelToMoveTo = levelToMoveTo;
+            AsyncWorldLoader::Begin(levelToMoveTo);
             Timer::SetTimer(1.f, &GameUtils::LoadWorldAndMoveToEntranceTrigger);
 
             UISystem::screenFadeWidget->SetToFadeOut();
@@ -109,12 +125,25 @@ void EntranceTrigger::Tick(float deltaTime)
     }
 }
 
+void EntranceTrigger::OnWorldSuspended()
+{
+    interactWidget->RemoveFromViewport();
+}
+
+void EntranceTrigger::OnWorldResumed()
+{
+    //The entrance the player left through is usable again when they walk back in.
+    entranceInteractedWith = false;
+    interactWidget->RemoveFromViewport();
+}
+
 Properties EntranceTrigger::GetProps()
 {
     auto props = Actor::GetProps();
     props.title = "EntranceTrigger";
     props.Add("Level Name", &levelToMoveTo).autoCompletePath = "/WorldMaps/";
     props.Add("Entrance Active", &isEntranceActive);
+    props.Add("Preload Radius", &preloadRadius);
     props.Add("Open Text", &openText);
     props.Add("Locked Text", &lockedText);
     return props;
@@ -122,15 +151,8 @@ Properties EntranceTrigger::GetProps()
 
 bool EntranceTrigger::CheckIfWorldExists(std::string& worldName)
 {
-    if (GameInstance::useGameSaves)
-    {
-        if (!std::filesystem::exists("GameSaves/" + worldName))
-        {
-            Log("GameSaves/[%s] not found for [%s]", worldName.c_str(), this->GetName().c_str());
-            return false;
-        }
-    }
-    else if (!std::filesystem::exists("WorldMaps/" + worldName))
+    //Game saves are built on top of the WorldMaps/ world, so that one has to exist either way.
+    if (!std::filesystem::exists("WorldMaps/" + worldName))
     {
         Log("WorldMaps/[%s] not found for [%s]", worldName.c_str(), this->GetName().c_str());
         return false;
@@ -144,6 +166,7 @@ void EntranceTrigger::UnlockEntrance()
     isEntranceActive = true;
     isEntranceLocked = false;
     interactWidget->interactText = openText;
+    MarkSaveDirty();
 
     SetCameraZoomFocusAndPopupWidget(" entrance unlocked.");
 }
@@ -153,6 +176,7 @@ void EntranceTrigger::LockEntrance()
     isEntranceActive = false;
     isEntranceLocked = true;
     interactWidget->interactText = lockedText;
+    MarkSaveDirty();
 
     SetCameraZoomFocusAndPopupWidget(" entrance locked.");
 }
@@ -23,6 +23,9 @@ struct EntranceTrigger : Actor
 	//text to show when entrance is locked
 	std::wstring lockedText = L"Locked";
 
+	//The level starts loading in the background once the player is this close to an open entrance.
+	float preloadRadius = 10.f;
+
 	bool isEntranceActive = true;
 	bool isEntranceLocked = false;
 
@@ -32,6 +35,8 @@ struct EntranceTrigger : Actor
 	EntranceTrigger();
 	virtual void Start() override;
 	virtual void Tick(float deltaTime) override;
+	virtual void OnWorldSuspended() override;
+	virtual void OnWorldResumed() override;
 	virtual Properties GetProps() override;
 
 	bool CheckIfWorldExists(std::string& worldName);
@@ -1,5 +1,10 @@
 #include "vpch.h"
 #include "Grid.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
 #include "Components/InstanceMeshComponent.h"
 #include "Render/RenderUtils.h"
 #include "Render/Material.h"
@@ -9,6 +14,8 @@
 #include "Unit.h"
 #include "Gameplay/BattleSystem.h"
 #include "Actors/Game/Player.h"
+#include "Actors/ActorTypeQuery.h"
+#include "Core/SystemScheduler.h"
 
 Grid::Grid()
 {
@@ -46,28 +53,26 @@ void Grid::Awake()
     HitResult hit(this);
     hit.ignoreLayer = CollisionLayers::Editor;
     hit.actorsToIgnore.push_back((Actor*)Player::system.GetFirstActor());
-    auto gridActors = World::GetAllActorsOfTypeAsActor<GridActor>();
-    for (auto gridActor : gridActors)
+    for (auto gridActor : ActorQueryRegistry::GetActorsOfType<GridActor>())
     {
-        auto castActor = (GridActor*)gridActor;
-        if (castActor)
+        if (gridActor->isGridObstacle)
         {
-            if (castActor->isGridObstacle)
-            {
-                continue;
-            }
+            continue;
         }
 
         hit.actorsToIgnore.push_back(gridActor);
     }
 
-    rows.clear();
+    NodeStateChanged();
+
+    nodes.clear();
+    nodes.reserve(meshInstanceCount);
+    nodeHeights.clear();
+    nodeHeights.reserve(meshInstanceCount);
+    searchNodes.assign(meshInstanceCount, GridSearchNode());
 
     for (int x = 0; x < sizeX; x++)
     {
-        //create grid row
-        rows.push_back(GridRow());
-
         for (int y = 0; y < sizeY; y++)
         {
             rayOrigin = XMVectorSet(x, 10.f, y, 1.f);
@@ -123,8 +128,8 @@ void Grid::Awake()
 
             nodeMesh->GetInstanceData().push_back(instanceData);
 
-            //Add node to column
-            rows[x].Add(node);
+            nodes.push_back(node);
+            nodeHeights.push_back(node.worldPosition.y);
         }
     }
 }
@@ -173,30 +178,30 @@ Properties Grid::GetProps()
 
 GridNode* Grid::GetNode(int x, int y)
 {
-    assert(x < rows.size());
-    assert(y < rows[x].columns.size());
-    return &rows[x].columns[y];
+    SYSTEM_ACCESS_CHECK(SystemResources::Grid, false);
+    assert(x < sizeX);
+    assert(y < sizeY);
+    return &nodes[GetNodeIndex(x, y)];
 }
 
 GridNode* Grid::GetNodeAllowNull(int x, int y)
 {
+    SYSTEM_ACCESS_CHECK(SystemResources::Grid, false);
     if (x < 0) return nullptr;
     if (y < 0) return nullptr;
     if (x >= sizeX) return nullptr;
     if (y >= sizeY) return nullptr;
-    return &rows[x].columns[y];
+    return &nodes[GetNodeIndex(x, y)];
 }
 
 std::vector<GridNode*> Grid::GetAllNodes()
 {
     std::vector<GridNode*> outNodes;
+    outNodes.reserve(nodes.size());
 
-    for (int x = 0; x < sizeX; x++)
+    for (auto& node : nodes)
     {
-        for (int y = 0; y < sizeX; y++)
-        {
-            outNodes.push_back(GetNode(x, y));
-        }
+        outNodes.push_back(&node);
     }
 
     return outNodes;
@@ -208,72 +213,343 @@ GridNode* Grid::GetNodeLimit(int x, int y)
     if (y < 0) y = 0;
     if (x >= sizeX) x = sizeX - 1;
     if (y >= sizeY) y = sizeY - 1;
-    return &rows[x].columns[y];
+    return &nodes[GetNodeIndex(x, y)];
 }
 
-void Grid::GetNeighbouringNodes(GridNode* centerNode, std::vector<GridNode*>& outNodes)
+void Grid::SetNodeHeight(GridNode* node, float height)
 {
-    int currentX = centerNode->xIndex;
-    int currentY = centerNode->yIndex;
+    float& nodeHeight = nodeHeights[GetNodeIndex(node)];
+    if (nodeHeight != height)
+    {
+        NodeStateChanged();
+    }
 
-    //+X
-    if (currentX < (sizeX - 1))
+    node->worldPosition.y = height;
+    nodeHeight = height;
+}
+
+GridSearchNode& Grid::BeginSearch(int startIndex)
+{
+    currentSearchID++;
+
+    GridSearchNode& startSearchNode = searchNodes[startIndex];
+    startSearchNode.searchID = currentSearchID;
+    startSearchNode.gCost = 0.f;
+    startSearchNode.parentIndex = -1;
+    startSearchNode.expanded = false;
+    return startSearchNode;
+}
+
+template <typename Func>
+void Grid::ForEachStep(int nodeIndex, int passThroughIndex, Func func)
+{
+    const int x = nodeIndex / sizeY;
+    const int y = nodeIndex % sizeY;
+    const float maxHeight = nodeHeights[nodeIndex] + Grid::maxHeightMove;
+
+    auto Step = [&](int stepIndex)
     {
-        GridNode& node = rows[currentX + 1].columns[currentY];
-        if (!node.closed && node.active)
+        if (nodeHeights[stepIndex] < maxHeight && (nodes[stepIndex].active || stepIndex == passThroughIndex))
+        {
+            func(stepIndex);
+        }
+    };
+
+    if (x < (sizeX - 1)) Step(nodeIndex + sizeY);
+    if (x > 0) Step(nodeIndex - sizeY);
+    if (y < (sizeY - 1)) Step(nodeIndex + 1);
+    if (y > 0) Step(nodeIndex - 1);
+}
+
+bool Grid::FindPath(GridNode* start, GridNode* goal, std::vector<GridNode*>& outPath)
+{
+    outPath.clear();
+
+    const int startIndex = GetNodeIndex(start);
+    const int goalIndex = GetNodeIndex(goal);
+
+    //Manhattan, steps are only ever along x or y.
+    auto Heuristic = [this, goal](int nodeIndex)
+    {
+        return static_cast<float>(std::abs(nodeIndex / sizeY - goal->xIndex) + std::abs(nodeIndex % sizeY - goal->yIndex));
+    };
+
+    GridSearchNode& startSearchNode = BeginSearch(startIndex);
+    startSearchNode.hCost = Heuristic(startIndex);
+
+    //(fCost, node index) min heap. Nodes are pushed again when a shorter way to them turns up,
+    //the stale entries are skipped as they come off.
+    using OpenNode = std::pair<float, int>;
+    std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> openNodes;
+    openNodes.emplace(startSearchNode.GetFCost(), startIndex);
+
+    int closestIndex = startIndex;
+
+    while (!openNodes.empty())
+    {
+        const int nodeIndex = openNodes.top().second;
+        openNodes.pop();
+
+        GridSearchNode& searchNode = searchNodes[nodeIndex];
+        if (searchNode.expanded)
+        {
+            continue;
+        }
+        searchNode.expanded = true;
+
+        if (searchNode.hCost < searchNodes[closestIndex].hCost)
+        {
+            closestIndex = nodeIndex;
+        }
+
+        if (nodeIndex == goalIndex)
+        {
+            break;
+        }
+
+        const float stepGCost = searchNode.gCost + 1.f;
+
+        ForEachStep(nodeIndex, goalIndex, [&](int stepIndex)
         {
-            if (node.worldPosition.y < (centerNode->worldPosition.y + Grid::maxHeightMove))
+            GridSearchNode& stepSearchNode = searchNodes[stepIndex];
+            if (stepSearchNode.searchID != currentSearchID)
             {
-                node.closed = true;
-                node.parentNode = centerNode;
-                outNodes.push_back(&node);
+                stepSearchNode.searchID = currentSearchID;
+                stepSearchNode.gCost = std::numeric_limits<float>::max();
+                stepSearchNode.hCost = Heuristic(stepIndex);
+                stepSearchNode.expanded = false;
             }
-        }
+
+            if (!stepSearchNode.expanded && stepGCost < stepSearchNode.gCost)
+            {
+                stepSearchNode.gCost = stepGCost;
+                stepSearchNode.parentIndex = nodeIndex;
+                openNodes.emplace(stepSearchNode.GetFCost(), stepIndex);
+            }
+        });
     }
 
-    //-X
-    if (currentX > 0)
+    BuildSearchPath(&nodes[closestIndex], outPath);
+    return closestIndex == goalIndex;
+}
+
+void Grid::FindReachableNodes(GridNode* start, int maxSteps, std::vector<GridNode*>& outNodes)
+{
+    outNodes.clear();
+
+    const int startIndex = GetNodeIndex(start);
+    BeginSearch(startIndex);
+
+    //Every step costs the same, so a breadth first flood reaches each node by its shortest path.
+    std::vector<int> frontier = { startIndex };
+    std::vector<int> nextFrontier;
+
+    for (int step = 1; step <= maxSteps && !frontier.empty(); step++)
     {
-        GridNode& node = rows[currentX - 1].columns[currentY];
-        if (!node.closed && node.active)
+        for (int nodeIndex : frontier)
         {
-            if (node.worldPosition.y < (centerNode->worldPosition.y + Grid::maxHeightMove))
+            ForEachStep(nodeIndex, -1, [&](int stepIndex)
             {
-                node.closed = true;
-                node.parentNode = centerNode;
-                outNodes.push_back(&node);
-            }
+                GridSearchNode& stepSearchNode = searchNodes[stepIndex];
+                if (stepSearchNode.searchID == currentSearchID)
+                {
+                    return;
+                }
+
+                stepSearchNode.searchID = currentSearchID;
+                stepSearchNode.gCost = static_cast<float>(step);
+                stepSearchNode.parentIndex = nodeIndex;
+                stepSearchNode.expanded = true;
+
+                nextFrontier.emplace_back(stepIndex);
+                outNodes.emplace_back(&nodes[stepIndex]);
+            });
         }
+
+        std::swap(frontier, nextFrontier);
+        nextFrontier.clear();
     }
+}
 
-    //+Y
-    if (currentY < (sizeY - 1))
+void Grid::BuildSearchPath(GridNode* node, std::vector<GridNode*>& outPath)
+{
+    outPath.clear();
+
+    int nodeIndex = GetNodeIndex(node);
+    if (searchNodes[nodeIndex].searchID != currentSearchID)
     {
-        GridNode& node = rows[currentX].columns[currentY + 1];
-        if (!node.closed && node.active)
+        return;
+    }
+
+    //Parents always lead back to the start (parentIndex -1), every node was stamped by this search.
+    while (searchNodes[nodeIndex].parentIndex >= 0)
+    {
+        outPath.emplace_back(&nodes[nodeIndex]);
+        nodeIndex = searchNodes[nodeIndex].parentIndex;
+    }
+
+    std::reverse(outPath.begin(), outPath.end());
+}
+
+void Grid::BuildDistanceField(const std::vector<GridNode*>& sources, GridDistanceField& outField)
+{
+    outField.distances.assign(nodes.size(), -1);
+    outField.sourceIndices.assign(nodes.size(), -1);
+    outField.nodeStateVersion = nodeStateVersion;
+
+    std::vector<int> frontier;
+    std::vector<int> nextFrontier;
+
+    for (int sourceIndex = 0; sourceIndex < static_cast<int>(sources.size()); sourceIndex++)
+    {
+        const int nodeIndex = GetNodeIndex(sources[sourceIndex]);
+        if (outField.distances[nodeIndex] == 0)
         {
-            if (node.worldPosition.y < (centerNode->worldPosition.y + Grid::maxHeightMove))
+            continue;
+        }
+
+        outField.distances[nodeIndex] = 0;
+        outField.sourceIndices[nodeIndex] = sourceIndex;
+        frontier.emplace_back(nodeIndex);
+    }
+
+    for (int distance = 1; !frontier.empty(); distance++)
+    {
+        for (int nodeIndex : frontier)
+        {
+            const int x = nodeIndex / sizeY;
+            const int y = nodeIndex % sizeY;
+
+            auto Reach = [&](int fromIndex)
             {
-                node.closed = true;
-                node.parentNode = centerNode;
-                outNodes.push_back(&node);
-            }
+                //Units step from fromIndex onto nodeIndex, so the height limit is checked that way round.
+                if (outField.distances[fromIndex] >= 0
+                    || nodeHeights[nodeIndex] >= nodeHeights[fromIndex] + Grid::maxHeightMove)
+                {
+                    return;
+                }
+
+                outField.distances[fromIndex] = distance;
+                outField.sourceIndices[fromIndex] = outField.sourceIndices[nodeIndex];
+
+                if (nodes[fromIndex].active)
+                {
+                    nextFrontier.emplace_back(fromIndex);
+                }
+            };
+
+            if (x < (sizeX - 1)) Reach(nodeIndex + sizeY);
+            if (x > 0) Reach(nodeIndex - sizeY);
+            if (y < (sizeY - 1)) Reach(nodeIndex + 1);
+            if (y > 0) Reach(nodeIndex - 1);
         }
+
+        std::swap(frontier, nextFrontier);
+        nextFrontier.clear();
     }
+}
 
-    //-Y
-    if (currentY > 0)
+bool Grid::FollowDistanceField(const GridDistanceField& field, GridNode* start, int maxSteps, int stopDistance,
+    int direction, std::vector<GridNode*>& outPath)
+{
+    outPath.clear();
+
+    if (field.distances.size() != nodes.size())
+    {
+        return false;
+    }
+
+    int nodeIndex = GetNodeIndex(start);
+    if (field.distances[nodeIndex] < 0)
     {
-        GridNode& node = rows[currentX].columns[currentY - 1];
-        if (!node.closed && node.active)
+        return false;
+    }
+
+    while (static_cast<int>(outPath.size()) < maxSteps)
+    {
+        const int distance = field.distances[nodeIndex];
+        if (direction < 0 && distance <= stopDistance)
+        {
+            break;
+        }
+
+        int nextIndex = -1;
+        int nextDistance = distance;
+        ForEachStep(nodeIndex, -1, [&](int stepIndex)
         {
-            if (node.worldPosition.y < (centerNode->worldPosition.y + Grid::maxHeightMove))
+            const int stepDistance = field.distances[stepIndex];
+            if (stepDistance >= 0 && (stepDistance - nextDistance) * direction > 0)
             {
-                node.closed = true;
-                node.parentNode = centerNode;
-                outNodes.push_back(&node);
+                nextIndex = stepIndex;
+                nextDistance = stepDistance;
             }
+        });
+
+        if (nextIndex < 0)
+        {
+            break;
         }
+
+        outPath.emplace_back(&nodes[nextIndex]);
+        nodeIndex = nextIndex;
+    }
+
+    return true;
+}
+
+bool Grid::DescendDistanceField(const GridDistanceField& field, GridNode* start, int maxSteps, int stopDistance,
+    std::vector<GridNode*>& outPath)
+{
+    return FollowDistanceField(field, start, maxSteps, stopDistance, -1, outPath);
+}
+
+bool Grid::AscendDistanceField(const GridDistanceField& field, GridNode* start, int maxSteps, std::vector<GridNode*>& outPath)
+{
+    return FollowDistanceField(field, start, maxSteps, 0, 1, outPath);
+}
+
+void Grid::GetNeighbouringNodes(GridNode* centerNode, std::vector<GridNode*>& outNodes)
+{
+    int currentX = centerNode->xIndex;
+    int currentY = centerNode->yIndex;
+
+    const int centerIndex = GetNodeIndex(currentX, currentY);
+    const float maxHeight = nodeHeights[centerIndex] + Grid::maxHeightMove;
+
+    //Closed and height checks only touch the search and height arrays, the node itself is read last.
+    auto AddNeighbour = [&](int nodeIndex)
+    {
+        GridSearchNode& searchNode = searchNodes[nodeIndex];
+        if (!searchNode.closed && nodeHeights[nodeIndex] < maxHeight && nodes[nodeIndex].active)
+        {
+            searchNode.closed = true;
+            searchNode.parentIndex = centerIndex;
+            outNodes.push_back(&nodes[nodeIndex]);
+        }
+    };
+
+    //+X
+    if (currentX < (sizeX - 1))
+    {
+        AddNeighbour(centerIndex + sizeY);
+    }
+
+    //-X
+    if (currentX > 0)
+    {
+        AddNeighbour(centerIndex - sizeY);
+    }
+
+    //+Y
+    if (currentY < (sizeY - 1))
+    {
+        AddNeighbour(centerIndex + 1);
+    }
+
+    //-Y
+    if (currentY > 0)
+    {
+        AddNeighbour(centerIndex - 1);
     }
 }
 
@@ -285,7 +561,7 @@ void Grid::GetNeighbouringNodesForceful(GridNode* centerNode, std::vector<GridNo
     //+X
     if (currentX < (sizeX - 1))
     {
-        GridNode& node = rows[currentX + 1].columns[currentY];
+        GridNode& node = nodes[GetNodeIndex(currentX + 1, currentY)];
         if (node.active)
         {
             outNodes.push_back(&node);
@@ -295,7 +571,7 @@ void Grid::GetNeighbouringNodesForceful(GridNode* centerNode, std::vector<GridNo
     //-X
     if (currentX > 0)
     {
-        GridNode& node = rows[currentX - 1].columns[currentY];
+        GridNode& node = nodes[GetNodeIndex(currentX - 1, currentY)];
         if (node.active)
         {
             outNodes.push_back(&node);
@@ -305,7 +581,7 @@ void Grid::GetNeighbouringNodesForceful(GridNode* centerNode, std::vector<GridNo
     //+Y
     if (currentY < (sizeY - 1))
     {
-        GridNode& node = rows[currentX].columns[currentY + 1];
+        GridNode& node = nodes[GetNodeIndex(currentX, currentY + 1)];
         if (node.active)
         {
             outNodes.push_back(&node);
@@ -315,7 +591,7 @@ void Grid::GetNeighbouringNodesForceful(GridNode* centerNode, std::vector<GridNo
     //-Y
     if (currentY > 0)
     {
-        GridNode& node = rows[currentX].columns[currentY - 1];
+        GridNode& node = nodes[GetNodeIndex(currentX, currentY - 1)];
         if (node.active)
         {
             outNodes.push_back(&node);
@@ -333,28 +609,28 @@ std::vector<GridNode*> Grid::GetNeighbouringActiveAndInactiveNodesForceful(GridN
     //+X
     if (currentX < (sizeX - 1))
     {
-        GridNode& node = rows[currentX + 1].columns[currentY];
+        GridNode& node = nodes[GetNodeIndex(currentX + 1, currentY)];
         outNodes.push_back(&node);
     }
 
     //-X
     if (currentX > 0)
     {
-        GridNode& node = rows[currentX - 1].columns[currentY];
+        GridNode& node = nodes[GetNodeIndex(currentX - 1, currentY)];
         outNodes.push_back(&node);
     }
 
     //+Y
     if (currentY < (sizeY - 1))
     {
-        GridNode& node = rows[currentX].columns[currentY + 1];
+        GridNode& node = nodes[GetNodeIndex(currentX, currentY + 1)];
         outNodes.push_back(&node);
     }
 
     //-Y
     if (currentY > 0)
     {
-        GridNode& node = rows[currentX].columns[currentY - 1];
+        GridNode& node = nodes[GetNodeIndex(currentX, currentY - 1)];
         outNodes.push_back(&node);
     }
 
@@ -402,7 +678,7 @@ std::vector<Unit*> Grid::GetAllUnitsFromNodes(std::vector<GridNode*>& nodes)
 std::vector<PlayerUnit*> Grid::GetAllPlayerUnitsAtNode(GridNode* node)
 {
     std::vector<PlayerUnit*> playerUnits;
-    for (auto playerUnit : World::GetAllActorsOfTypeInWorld<PlayerUnit>())
+    for (auto playerUnit : ActorQueryRegistry::GetActorsOfType<PlayerUnit>())
     {
         if (node->Equals(playerUnit->xIndex, playerUnit->yIndex))
         {
@@ -414,12 +690,11 @@ std::vector<PlayerUnit*> Grid::GetAllPlayerUnitsAtNode(GridNode* node)
 
 void Grid::ResetAllNodes()
 {
-    for (auto& row : rows)
+    searchNodes.assign(searchNodes.size(), GridSearchNode());
+
+    for (auto& node : nodes)
     {
-        for (auto& node : row.columns)
-        {
-            node.ResetValues();
-        }
+        node.preview = false;
     }
 }
 
@@ -427,20 +702,17 @@ void Grid::LerpInNodes(float deltaTime)
 {
     const float lerpSpeed = 4.5f;
 
-    for (auto& row : rows)
+    for (auto& node : nodes)
     {
-        for (auto& node : row.columns)
+        if (!node.active || node.preview)
         {
-            if (!node.active || node.preview)
-            {
-                continue;
-            }
-
-            auto& data = nodeMesh->GetInstanceData()[node.instancedMeshIndex];
-            data.world.r[0].m128_f32[0] = std::lerp(data.world.r[0].m128_f32[0], 0.f, deltaTime * lerpSpeed);
-            data.world.r[1].m128_f32[1] = std::lerp(data.world.r[1].m128_f32[1], 0.f, deltaTime * lerpSpeed);
-            data.world.r[2].m128_f32[2] = std::lerp(data.world.r[2].m128_f32[2], 0.f, deltaTime * lerpSpeed);
+            continue;
         }
+
+        auto& data = nodeMesh->GetInstanceData()[node.instancedMeshIndex];
+        data.world.r[0].m128_f32[0] = std::lerp(data.world.r[0].m128_f32[0], 0.f, deltaTime * lerpSpeed);
+        data.world.r[1].m128_f32[1] = std::lerp(data.world.r[1].m128_f32[1], 0.f, deltaTime * lerpSpeed);
+        data.world.r[2].m128_f32[2] = std::lerp(data.world.r[2].m128_f32[2], 0.f, deltaTime * lerpSpeed);
     }
 }
 
@@ -448,20 +720,17 @@ void Grid::LerpOutNodes(float deltaTime)
 {
     const float lerpSpeed = 4.5f;
 
-    for (auto& row : rows)
+    for (auto& node : nodes)
     {
-        for (auto& node : row.columns)
+        if (!node.active || node.preview)
         {
-            if (!node.active || node.preview) 
-            {
-                continue; 
-            }
-
-            auto& data = nodeMesh->GetInstanceData()[node.instancedMeshIndex];
-            data.world.r[0].m128_f32[0] = std::lerp(data.world.r[0].m128_f32[0], 0.9f, deltaTime * lerpSpeed);
-            data.world.r[1].m128_f32[1] = std::lerp(data.world.r[1].m128_f32[1], 0.9f, deltaTime * lerpSpeed);
-            data.world.r[2].m128_f32[2] = std::lerp(data.world.r[2].m128_f32[2], 0.9f, deltaTime * lerpSpeed);
+            continue;
         }
+
+        auto& data = nodeMesh->GetInstanceData()[node.instancedMeshIndex];
+        data.world.r[0].m128_f32[0] = std::lerp(data.world.r[0].m128_f32[0], 0.9f, deltaTime * lerpSpeed);
+        data.world.r[1].m128_f32[1] = std::lerp(data.world.r[1].m128_f32[1], 0.9f, deltaTime * lerpSpeed);
+        data.world.r[2].m128_f32[2] = std::lerp(data.world.r[2].m128_f32[2], 0.9f, deltaTime * lerpSpeed);
     }
 }
 
@@ -469,12 +738,9 @@ void Grid::DisplayHideAllNodes()
 {
     lerpValue = LerpValue::LerpIn;
 
-    for (auto& row : rows)
+    for (auto& node : nodes)
     {
-        for (auto& node : row.columns)
-        {
-            node.DisplayHide();
-        }
+        node.DisplayHide();
     }
 }
 
@@ -482,12 +748,9 @@ void Grid::DisplayShowAllNodes()
 {
     lerpValue = LerpValue::LerpOut;
 
-    for (auto& row : rows)
+    for (auto& node : nodes)
     {
-        for (auto& node : row.columns)
-        {
-            node.DisplayShow();
-        }
+        node.DisplayShow();
     }
 }
 
@@ -14,19 +14,14 @@ struct Grid : public Actor
 {
 	ACTOR_SYSTEM(Grid);
 
-	struct GridRow
-	{
-		std::vector<GridNode> columns;
-
-		void Add(GridNode node)
-		{
-			columns.emplace_back(node);
-		}
-	};
-
 	InstanceMeshComponent* nodeMesh = nullptr;
 
-	std::vector<GridRow> rows;
+	//sizeX rows of sizeY nodes each, see GetNodeIndex().
+	std::vector<GridNode> nodes;
+
+	//Parallel to nodes. Neighbour and path searches mostly read these, so they're kept out of GridNode.
+	std::vector<float> nodeHeights;
+	std::vector<GridSearchNode> searchNodes;
 
 	inline static float maxHeightMove = 1.0f;
 
@@ -52,11 +47,54 @@ struct Grid : public Actor
 	GridNode* GetNode(int x, int y);
 	GridNode* GetNodeAllowNull(int x, int y);
 
+	int GetNodeIndex(int x, int y) { return x * sizeY + y; }
+	int GetNodeIndex(GridNode* node) { return GetNodeIndex(node->xIndex, node->yIndex); }
+	GridSearchNode& GetSearchNode(GridNode* node) { return searchNodes[GetNodeIndex(node)]; }
+
+	//Keeps nodeHeights in step with the node's world position.
+	void SetNodeHeight(GridNode* node, float height);
+
+	//Called when the terrain changes (SetNodeHeight(), Awake(), an obstacle being destroyed) so distance fields built
+	//before then are rebuilt before they're walked. Units stepping on and off nodes don't count, fields are walked
+	//against each node's live active flag.
+	void NodeStateChanged() { nodeStateVersion++; }
+	bool IsDistanceFieldCurrent(const GridDistanceField& field)
+	{
+		return field.nodeStateVersion == nodeStateVersion && field.distances.size() == nodes.size();
+	}
+
 	std::vector<GridNode*> GetAllNodes();
 
 	//Limit the node gotten between 0 and the size of the grid.
 	GridNode* GetNodeLimit(int x, int y);
 
+	//A* from start to goal over active nodes, only stepping up to nodes under maxHeightMove higher.
+	//Inactive nodes (obstacles, nodes units are stood on) are walls, except for goal itself.
+	//outPath runs from the node after start through to goal, or through to the node closest to goal
+	//when it can't be reached. Returns whether goal was reached.
+	bool FindPath(GridNode* start, GridNode* goal, std::vector<GridNode*>& outPath);
+
+	//Every node reachable from start in at most maxSteps, nearest first and not including start.
+	//Follow up with BuildSearchPath() for the path to any of them.
+	void FindReachableNodes(GridNode* start, int maxSteps, std::vector<GridNode*>& outNodes);
+
+	//Path from the last FindPath()/FindReachableNodes() start through to node, not including start.
+	void BuildSearchPath(GridNode* node, std::vector<GridNode*>& outPath);
+
+	//Floods out from every source at once against the way units step, so each node ends up with the number of
+	//steps from it to its nearest source. Inactive nodes get a distance for whoever is stood on them, but the
+	//flood doesn't pass through them. One field serves every unit heading for (or away from) the same sources.
+	void BuildDistanceField(const std::vector<GridNode*>& sources, GridDistanceField& outField);
+
+	//Path of up to maxSteps from start, each step to the neighbouring node nearest a source, until a node at
+	//stopDistance or closer is reached. Returns false if start can't reach a source or the field is from
+	//before the last Awake(), search the grid instead.
+	bool DescendDistanceField(const GridDistanceField& field, GridNode* start, int maxSteps, int stopDistance,
+		std::vector<GridNode*>& outPath);
+
+	//Same as DescendDistanceField() but stepping away from sources, until no neighbouring node is further.
+	bool AscendDistanceField(const GridDistanceField& field, GridNode* start, int maxSteps, std::vector<GridNode*>& outPath);
+
 	void GetNeighbouringNodes(GridNode* centerNode, std::vector<GridNode*>& outNodes);
 
 	//Get neighbouring nodes without consideration for whether they're closed or their world position (only active nodes count).
@@ -73,10 +111,26 @@ struct Grid : public Actor
 	//For PlayerUnit fusion battle mechanic.
 	std::vector<PlayerUnit*> GetAllPlayerUnitsAtNode(GridNode* node);
 
+	//Clears search data and preview state.
 	void ResetAllNodes();
 	void LerpInNodes(float deltaTime);
 	void LerpOutNodes(float deltaTime);
 	void DisplayHideAllNodes();
 	void DisplayShowAllNodes();
 	void DisarmAllTrapNodes();
+
+private:
+	//Starts a new FindPath()/FindReachableNodes(), making every node's search data stale.
+	GridSearchNode& BeginSearch(int startIndex);
+
+	//Calls func with each node index a unit can step to from nodeIndex, allowing passThroughIndex even if inactive.
+	template <typename Func>
+	void ForEachStep(int nodeIndex, int passThroughIndex, Func func);
+
+	//Direction is -1 to descend, 1 to ascend.
+	bool FollowDistanceField(const GridDistanceField& field, GridNode* start, int maxSteps, int stopDistance,
+		int direction, std::vector<GridNode*>& outPath);
+
+	uint32_t currentSearchID = 0;
+	uint32_t nodeStateVersion = 0;
 };
@@ -66,14 +66,7 @@ Properties GridActor::GetProps()
 {
 	auto props = Actor::GetProps();
 	props.title = "GridActor";
-	props.Add("Destruct", &isDestructible);
-	props.Add("Health", &health);
-	props.Add("Interact", &isInteractable);
-	props.Add("Inspect", &isInspectable);
-	props.Add("Interact Text", &interactText);
-	props.Add("InteractKnownText", &interactKnownText);
-	props.Add("DisableGridInteract", &disableGridInteract);
-	props.Add("Obstacle", &isGridObstacle);
+	Reflection::AddFields(props, this);
 	return props;
 }
 
@@ -84,6 +77,7 @@ void GridActor::InflictDamage(int damage)
 	if (!isDestructible) return;
 
 	health -= damage;
+	MarkSaveDirty();
 	if (healthWidget)
 	{
 		healthWidget->healthPoints = health;
@@ -91,6 +85,12 @@ void GridActor::InflictDamage(int damage)
 
 	if (health <= 0)
 	{
+		//The node opening up changes the ground distance fields were built over, a Unit moving off it doesn't.
+		if (isGridObstacle)
+		{
+			Grid::system.GetFirstActor()->NodeStateChanged();
+		}
+
 		GetCurrentNode()->Show();
 		HitResult hit(this);
 		GetCurrentNode()->RecalcNodeHeight(hit);
@@ -3,6 +3,7 @@
 #include "../Actor.h"
 #include "../ActorSystem.h"
 #include "Gameplay/ForwardFace.h"
+#include "Core/Reflection.h"
 
 struct MeshComponent;
 struct HealthWidget;
@@ -75,3 +76,13 @@ struct GridActor : Actor
 	//Get forward face in grid terms based on forward vector and current grid position.
 	ForwardFace GetCurrentForwardFace();
 };
+
+REFLECT_FIELDS(GridActor,
+	ReflectField("Destruct", &GridActor::isDestructible),
+	ReflectField("Health", &GridActor::health),
+	ReflectField("Interact", &GridActor::isInteractable),
+	ReflectField("Inspect", &GridActor::isInspectable),
+	ReflectField("Interact Text", &GridActor::interactText),
+	ReflectField("InteractKnownText", &GridActor::interactKnownText),
+	ReflectField("DisableGridInteract", &GridActor::disableGridInteract),
+	ReflectField("Obstacle", &GridActor::isGridObstacle))
@@ -9,6 +9,7 @@
 #include "UI/UISystem.h"
 #include "Core/Input.h"
 #include "Actors/Game/Player.h"
+#include "Actors/ActorNameIndex.h"
 
 InteractTrigger::InteractTrigger()
 {
@@ -22,6 +23,10 @@ InteractTrigger::InteractTrigger()
 void InteractTrigger::Start()
 {
 	trigger->SetTargetAsPlayer();
+
+	//Sleep while the player is out of reach. Input is polled per frame, so never tick at a reduced rate.
+	tickSchedule.lodNearDistance = trigger->GetWorldBoundingRadius() + 1.f;
+	tickSchedule.lodSleepDistance = tickSchedule.lodNearDistance;
 	
 	interactWidget = UISystem::CreateWidget<InteractWidget>();
 	interactWidget->interactText = overlapText;
@@ -66,7 +71,7 @@ void InteractTrigger::Tick(float deltaTime)
 					}
 				}
 
-				Actor* targetActor = World::GetActorByNameAllowNull(targetActorName);
+				Actor* targetActor = ActorNameIndex::Find(targetActorName);
 				if (targetActor)
 				{
 					GameUtils::SetActiveCameraTargetAndZoomIn(targetActor);
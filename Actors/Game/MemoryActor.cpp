@@ -70,5 +70,6 @@ void MemoryActor::ActivateFromMemory()
         Grid::system.GetFirstActor()->Awake();
 
         isMemoryCreated = true;
+        MarkSaveDirty();
     }
 }
@@ -14,6 +14,10 @@ void NPC::Start()
 {
     __super::Start();
 
+    //NPCs out past the player's surroundings only need to keep wandering.
+    tickSchedule.lodNearDistance = 20.f;
+    tickSchedule.lodFarFrameDivisor = 4;
+
     if (!spawnText.empty())
     {
         if (isQuickDialogueActive) return;
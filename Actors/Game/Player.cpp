@@ -35,6 +35,7 @@
 #include "Render/Material.h"
 #include "Render/BlendStates.h"
 #include "Actors/Game/AllyUnits/AttackUnit.h"
+#include "Actors/ActorTypeQuery.h"
 
 Player::Player()
 {
@@ -71,12 +72,18 @@ void Player::Start()
 void Player::End()
 {
 	previousHitTransparentActors.clear();
+
+	ActorTickScheduler::hasFocus = false;
 }
 
 void Player::Tick(float deltaTime)
 {
 	__super::Tick(deltaTime);
 
+	//Distance based tick LOD for every other actor is measured from the player.
+	XMStoreFloat3(&ActorTickScheduler::focusPosition, GetPositionV());
+	ActorTickScheduler::hasFocus = true;
+
 	if (gameOver)
 	{
 		return;
@@ -155,8 +162,8 @@ void Player::BattleCleanup()
 
 	battleCardsInHand.clear();
 
-	auto playerUnits = World::GetAllActorsOfTypeInWorld<PlayerUnit>();
-	for (auto playerUnit : playerUnits)
+	//Removes are queued, so the view stays valid while player units are destroyed in it.
+	for (auto playerUnit : ActorQueryRegistry::GetActorsOfType<PlayerUnit>())
 	{
 		if (!playerUnit->isMainPlayer)
 		{
@@ -283,9 +290,10 @@ void Player::PrimaryAction()
 		if (inInteraction)
 		{
 			//End interact with GridActor
-			if (gridActorInteractingWith == nullptr) return;
-			gridActorInteractingWith->EndInteract();
-			gridActorInteractingWith = nullptr;
+			GridActor* gridActor = gridActorInteractingWith.Get();
+			if (gridActor == nullptr) return;
+			gridActor->EndInteract();
+			gridActorInteractingWith.Reset();
 
 			interactWidget->RemoveFromViewport();
 			inInteraction = false;
@@ -414,15 +422,24 @@ void Player::MakeOccludingMeshBetweenCameraAndPlayerTransparent()
 	const float transparentValue = 0.35f;
 	const float solidValue = 1.f;
 
+	//Previously hit actors can be Destroy()ed in between frames, handles resolve to null if so.
+	auto ResetPreviousHitActorsAlpha = [&]() {
+		for (auto& previousHitActor : previousHitTransparentActors)
+		{
+			Actor* actor = previousHitActor.Get();
+			if (actor)
+			{
+				SetActorAlpha(actor, solidValue);
+			}
+		}
+	};
+
 	HitResult hit(this);
 	if (OrientedBoxCast(hit, camera->GetWorldPositionV(), GetPositionV(), XMFLOAT2(0.5f, 0.5f), true))
 	{
-		std::vector<Actor*> ableActors;
+		std::vector<ActorHandle<Actor>> ableActors;
 
-		for (auto actor : previousHitTransparentActors)
-		{
-			SetActorAlpha(actor, solidValue);
-		}
+		ResetPreviousHitActorsAlpha();
 
 		for (auto actor : hit.hitActors)
 		{
@@ -437,10 +454,7 @@ void Player::MakeOccludingMeshBetweenCameraAndPlayerTransparent()
 	}
 	else
 	{
-		for(auto actor : previousHitTransparentActors)
-		{
-			SetActorAlpha(actor, solidValue);
-		}
+		ResetPreviousHitActorsAlpha();
 
 		previousHitTransparentActors.clear();
 	}
@@ -675,7 +689,7 @@ bool Player::AttackGridActorBasedOnNode()
 	const int attackNodeIndexY = yIndex + GetForwardVector().z;
 	auto attackNode = grid->GetNodeLimit(attackNodeIndexX, attackNodeIndexY);
 
-	for (auto gridActor : World::GetAllActorsOfTypeInWorld<GridActor>())
+	for (auto gridActor : ActorQueryRegistry::GetActorsOfType<GridActor>())
 	{
 		if (gridActor->GetCurrentNode()->Equals(attackNode))
 		{
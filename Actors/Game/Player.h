@@ -2,6 +2,7 @@
 
 #include "PlayerUnit.h"
 #include "Actors/ActorSystem.h"
+#include "Actors/ActorHandle.h"
 #include "Gameplay/BattleEnums.h"
 #include "Gameplay/PlayerInputController.h"
 #include "Components/MeshComponent.h"
@@ -32,9 +33,9 @@ public:
 	PlayerHealthWidget* healthWidget = nullptr;
 	BattleCardHandWidget* battleCardHandWidget = nullptr;
 
-	GridActor* gridActorInteractingWith = nullptr;
+	ActorHandle<GridActor> gridActorInteractingWith;
 
-	std::vector<Actor*> previousHitTransparentActors;
+	std::vector<ActorHandle<Actor>> previousHitTransparentActors;
 
 	std::vector<BattleCard*> battleCardsInHand;
 	
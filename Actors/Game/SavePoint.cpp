@@ -13,6 +13,10 @@ SavePoint::SavePoint()
 void SavePoint::Start()
 {
 	trigger->SetTargetAsPlayer();
+
+	//Same as other triggers, only awake when the player could be standing in it.
+	tickSchedule.lodNearDistance = trigger->GetWorldBoundingRadius() + 1.f;
+	tickSchedule.lodSleepDistance = tickSchedule.lodNearDistance;
 }
 
 void SavePoint::Tick(float deltaTime)
@@ -20,6 +20,7 @@
 #include "Gameplay/GameInstance.h"
 #include "Actors/Game/EntranceTrigger.h"
 #include "Physics/Raycast.h"
+#include "Actors/ActorTypeQuery.h"
 
 Unit::Unit()
 {
@@ -121,14 +122,15 @@ void Unit::Tick(float deltaTime)
 					EndTurn();
 
 					//Destroy Unit if its escaping and within its entrancetrigger to escape with
-					if (battleState.Compare(BattleStates::escape) && entranceToEscapeTo)
+					EntranceTrigger* entrance = entranceToEscapeTo.Get();
+					if (battleState.Compare(BattleStates::escape) && entrance)
 					{
-						if (entranceToEscapeTo->trigger->Contains(GetPositionV()))
+						if (entrance->trigger->Contains(GetPositionV()))
 						{
 							battleSystem.RemoveUnit(this);
 							GetCurrentNode()->Show();
 							Log("Unit [%s] escaped through [%s].",
-								this->GetName().c_str(), entranceToEscapeTo->GetName().c_str());
+								this->GetName().c_str(), entrance->GetName().c_str());
 							Destroy();
 							return;
 						}
@@ -144,14 +146,7 @@ void Unit::Tick(float deltaTime)
 Properties Unit::GetProps()
 {
 	auto props = __super::GetProps();
-	props.Add("Move Points", &movementPoints);
-	props.Add("Move Speed", &moveSpeed);
-	props.Add("Attack Points", &attackPoints);
-	props.Add("Attack Range", &attackRange);
-	props.Add("Battle State", &battleState);
-	props.Add("Focus Actor", &actorToFocusOn);
-	props.Add("Num Attacks", &numOfAttacks);
-	props.Add("Death Text", &deathText);
+	Reflection::AddFields(props, this);
 	return props;
 }
 
@@ -184,100 +179,49 @@ void Unit::MoveToNode(GridNode* destinationNode)
 	auto grid = Grid::system.GetFirstActor();
 	GridNode* startingNode = grid->GetNode(xIndex, yIndex);
 
-	std::vector<GridNode*> nodes;
-	std::vector<GridNode*> closedNodes;
-
-	grid->GetNeighbouringNodes(startingNode, nodes);
-
-	for (int moveIndex = 0; moveIndex < movementPoints; moveIndex++)
-	{
-		for (int previewIndex = 0; previewIndex < nodes.size(); previewIndex++)
-		{
-			grid->GetNeighbouringNodes(nodes[previewIndex], closedNodes);
-		}
-
-		nodes.insert(nodes.end(), closedNodes.begin(), closedNodes.end());
-
-		closedNodes.clear();
-	}
-
-	for (GridNode* node : nodes)
-	{
-		//reset the closes state
-		node->closed = false;
-
-		movementPathNodes.push_back(node);
-	}
+	pathNodes.clear();
 
-	//Assign all costs
-	for (auto node : movementPathNodes)
+	//Move to the node furthest away from destination this turn's movement can reach
+	if (battleState.Compare(BattleStates::evade))
 	{
-		//Assigning g/hCosts here based on world positions to account for node heights
-		XMVECTOR startPos = XMLoadFloat3(&startingNode->worldPosition);
-		XMVECTOR endPos = XMLoadFloat3(&destinationNode->worldPosition);
-		XMVECTOR currentPos = XMLoadFloat3(&node->worldPosition);
-
-		node->gCost = XMVector3Length(startPos - currentPos).m128_f32[0];
-		node->hCost = XMVector3Length(endPos - currentPos).m128_f32[0];
-	}
+		grid->FindReachableNodes(startingNode, movementPoints, movementPathNodes);
 
-	GridNode* nextNode = nullptr;
+		const XMVECTOR destinationPos = XMLoadFloat3(&destinationNode->worldPosition);
+		float highestDistance = XMVector3Length(destinationPos - XMLoadFloat3(&startingNode->worldPosition)).m128_f32[0];
+		GridNode* furthestNode = nullptr;
 
-	int highestHCostIndex = 0;
-	int lowestHCostIndex = 0;
-
-	//Move to node furthest away from destination
-	if (battleState.Compare(BattleStates::evade))
-	{
-		float highestHCost = 0.f;
-		for (int i = 0; i < movementPathNodes.size(); i++)
+		for (GridNode* node : movementPathNodes)
 		{
-			if (movementPathNodes[i]->hCost > highestHCost)
+			const float distance = XMVector3Length(destinationPos - XMLoadFloat3(&node->worldPosition)).m128_f32[0];
+			if (distance > highestDistance)
 			{
-				highestHCost = movementPathNodes[i]->hCost;
-				highestHCostIndex = i;
-				nextNode = movementPathNodes[i];
+				highestDistance = distance;
+				furthestNode = node;
 			}
 		}
-	}
-	else //Move towards destination
-	{
-		float lowestHCost = std::numeric_limits<float>::max();
-		for (int i = 0; i < movementPathNodes.size(); i++)
+
+		if (furthestNode)
 		{
-			if (movementPathNodes[i]->hCost < lowestHCost)
-			{
-				lowestHCost = movementPathNodes[i]->hCost;
-				lowestHCostIndex = i;
-				nextNode = movementPathNodes[i];
-			}
+			grid->BuildSearchPath(furthestNode, pathNodes);
 		}
+
+		movementPathNodes.clear();
+		return;
 	}
-	
 
-	//This needs to be here if you need Units moving exactly to a point, but most times
-	// the unit is going to be moving to a surrounding node if there is a target, eg. the unit
-	// isn't going to move onto the node of the player, instead to a neighbouring node
-	//if (nextNode != nullptr)
-	//{
-	//	pathNodes.push_back(nextNode);
-	//}
+	//Move towards destination
+	grid->FindPath(startingNode, destinationNode, pathNodes);
 
-	if (nextNode)
+	//Units move to a surrounding node rather than onto whatever is stood at the destination, eg. the player.
+	if (!pathNodes.empty() && pathNodes.back() == destinationNode && !destinationNode->active)
 	{
-		while (nextNode != startingNode)
-		{
-			if (nextNode->parentNode)
-			{
-				nextNode = nextNode->parentNode;
-				pathNodes.push_back(nextNode);
-			}
-		}
+		pathNodes.pop_back();
 	}
 
-	std::reverse(pathNodes.begin(), pathNodes.end());
-
-	movementPathNodes.clear();
+	if (pathNodes.size() > static_cast<size_t>(movementPoints))
+	{
+		pathNodes.resize(movementPoints);
+	}
 }
 
 void Unit::MoveToNode(int x, int y)
@@ -292,43 +236,68 @@ void Unit::StartTurn()
 {
 	isUnitTurn = true;
 
-	GetCurrentNode()->Show();
+	auto grid = Grid::system.GetFirstActor();
+	GridNode* currentNode = GetCurrentNode();
+	currentNode->Show();
 
-	auto target = FindClosestPlayerUnit();
+	pathNodes.clear();
 
+	//Paths come from the distance fields BattleSystem shares between every Unit's turn.
+	//Units only search the grid themselves when their node isn't in a field (e.g. walled off).
 	if (battleState.Compare(BattleStates::fight))
 	{
-		//Move towards player to attack
-		MoveToNode(target->xIndex, target->yIndex);
+		//Move towards player to attack, stopping next to them
+		if (!grid->DescendDistanceField(battleSystem.GetPlayerUnitField(), currentNode, movementPoints, 1, pathNodes))
+		{
+			auto target = FindClosestPlayerUnit();
+			MoveToNode(target->xIndex, target->yIndex);
+		}
 	}
 	else if (battleState.Compare(BattleStates::evade))
 	{
 		//Move away from player to evade
-		MoveToNode(target->xIndex, target->yIndex);
+		if (!grid->AscendDistanceField(battleSystem.GetPlayerUnitField(), currentNode, movementPoints, pathNodes))
+		{
+			auto target = FindClosestPlayerUnit();
+			MoveToNode(target->xIndex, target->yIndex);
+		}
 	}
 	else if (battleState.Compare(BattleStates::escape))
 	{
-		//int is the index into EntranceTrigger actor system vector
-		std::vector<std::pair<float, int>> entranceDistances;
-
-		//Find entrance closest to unit and move to it
-		for (int i = 0; i < EntranceTrigger::system.GetActors().size(); i++)
+		//Move onto the closest entrance's node
+		EntranceTrigger* entrance = battleSystem.GetClosestEntrance(currentNode);
+		if (entrance)
 		{
-			auto& entrance = EntranceTrigger::system.GetActors()[i];
-			float dist = XMVector3Length(entrance->GetPositionV() - this->GetPositionV()).m128_f32[0];
-			entranceDistances.push_back(std::make_pair(dist, i));
+			entranceToEscapeTo = entrance;
+			grid->DescendDistanceField(battleSystem.GetEntranceField(), currentNode, movementPoints, 0, pathNodes);
 		}
+		else if (!EntranceTrigger::system.GetActors().empty())
+		{
+			//int is the index into EntranceTrigger actor system vector
+			std::vector<std::pair<float, int>> entranceDistances;
 
-		//Sort by distance
-		std::sort(entranceDistances.begin(), entranceDistances.end());
-		auto& entranceTriggerToMoveTo = EntranceTrigger::system.GetActors()[entranceDistances.front().second];
+			//Find entrance closest to unit and move to it
+			for (int i = 0; i < EntranceTrigger::system.GetActors().size(); i++)
+			{
+				auto& entrance = EntranceTrigger::system.GetActors()[i];
+				float dist = XMVector3Length(entrance->GetPositionV() - this->GetPositionV()).m128_f32[0];
+				entranceDistances.push_back(std::make_pair(dist, i));
+			}
+
+			//Sort by distance
+			std::sort(entranceDistances.begin(), entranceDistances.end());
+			auto& entranceTriggerToMoveTo = EntranceTrigger::system.GetActors()[entranceDistances.front().second];
 
-		entranceToEscapeTo = entranceTriggerToMoveTo.get();
+			entranceToEscapeTo = entranceTriggerToMoveTo.get();
 
-		//EntranceTrigger isn't a grid actor, just move to its world position
-		int xIndex = std::round(entranceTriggerToMoveTo->GetPosition().x);
-		int yIndex = std::round(entranceTriggerToMoveTo->GetPosition().y);
-		MoveToNode(xIndex, yIndex);
+			//EntranceTrigger isn't a grid actor, just move to the node under its world position
+			int xIndex = std::round(entranceTriggerToMoveTo->GetPosition().x);
+			int yIndex = std::round(entranceTriggerToMoveTo->GetPosition().z);
+			if (grid->GetNodeAllowNull(xIndex, yIndex))
+			{
+				MoveToNode(xIndex, yIndex);
+			}
+		}
 	}
 }
 
@@ -391,12 +360,20 @@ void Unit::WindUpAttack()
 
 PlayerUnit* Unit::FindClosestPlayerUnit()
 {
-	std::multimap<float, PlayerUnit*> distanceMap;
-	for (auto playerUnit : World::GetAllActorsOfTypeInWorld<PlayerUnit>())
+	PlayerUnit* closestPlayerUnit = nullptr;
+	float closestDistance = std::numeric_limits<float>::max();
+
+	for (auto playerUnit : ActorQueryRegistry::GetActorsOfType<PlayerUnit>())
 	{
-		distanceMap.emplace(XMVector3Length(playerUnit->GetPositionV() - GetPositionV()).m128_f32[0], playerUnit);
+		const float distance = XMVector3Length(playerUnit->GetPositionV() - GetPositionV()).m128_f32[0];
+		if (distance < closestDistance)
+		{
+			closestDistance = distance;
+			closestPlayerUnit = playerUnit;
+		}
 	}
-	return distanceMap.begin()->second;
+
+	return closestPlayerUnit;
 }
 
 void Unit::ShowUnitMovementPath()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "GridActor.h"
+#include "Actors/ActorHandle.h"
 #include <memory>
 #include "Core/VEnum.h"
 #include "Gameplay/BattleEnums.h"
@@ -33,7 +34,7 @@ struct Unit : GridActor
 	//Meant to show a unit's current focus in battle and in world
 	Polyboard* intentBeam = nullptr;
 
-	EntranceTrigger* entranceToEscapeTo = nullptr;
+	ActorHandle<EntranceTrigger> entranceToEscapeTo;
 
 	//Text to display on unit's death during battle
 	std::wstring deathText;
@@ -93,3 +94,13 @@ private:
 	std::vector<GridNode*> GetMovementPathPreviewNodes(GridNode* destinationNode);
 	PlayerUnit* FindClosestPlayerUnit();
 };
+
+REFLECT_FIELDS(Unit,
+	ReflectField("Move Points", &Unit::movementPoints),
+	ReflectField("Move Speed", &Unit::moveSpeed),
+	ReflectField("Attack Points", &Unit::attackPoints),
+	ReflectField("Attack Range", &Unit::attackRange),
+	ReflectField("Battle State", &Unit::battleState),
+	ReflectField("Focus Actor", &Unit::actorToFocusOn),
+	ReflectField("Num Attacks", &Unit::numOfAttacks),
+	ReflectField("Death Text", &Unit::deathText))
@@ -1,8 +1,14 @@
 #pragma once
 
 #include <string>
+#include <memory>
+#include "TickSchedule.h"
+#include "Core/SystemAccess.h"
 
 class Actor;
+class DetachedSystem;
+class PropsSchema;
+class PackedRecords;
 class Serialiser;
 class BinarySerialiser;
 class Deserialiser;
@@ -13,24 +19,66 @@ class IActorSystem
 {
 public:
 	virtual void Tick(float deltaTime) = 0;
+
+	//What Tick() reads and writes, for SystemScheduler. Declared with SYSTEM_ACCESS() on the actor type.
+	virtual SystemAccess GetAccess() = 0;
 	virtual void Init() = 0;
 	virtual void PostInit() = 0;
 	std::string GetName() { return name; }
 	virtual std::vector<Actor*> GetActorsAsBaseClass() = 0;
 	virtual Actor* SpawnActor(const Transform& transform) = 0;
+
+	//Spawns count actors in one go (e.g. world loads, summons). transforms is empty or one per actor.
+	virtual std::vector<Actor*> SpawnBatch(size_t count, const std::vector<Transform>& transforms) = 0;
 	virtual Actor* FindActorByName(std::string actorName) = 0;
 	virtual uint32_t GetNumActors() = 0;
+	virtual Actor* GetActorByIndex(uint32_t index) = 0;
+
+	//Actors queued by Destroy() stay in the system until the next flush, queries skip them.
+	virtual bool IsActorPendingDestroy(uint32_t index) = 0;
+
+	//Counts of ticked, skipped and sleeping actors from the last Tick().
+	virtual ActorTickStats GetTickStats() = 0;
+
+	//Returns the actor an ActorHandle refers to, or nullptr if it has since been removed.
+	virtual Actor* ResolveHandle(uint32_t slot, uint32_t generation) = 0;
 
 	//Destroys an actor through its linked ActorSystem when its base class does not ACTOR_SYSTEM() defined.
+	//Queued the same as Destroy(), see ActorSystem::QueueRemove().
 	virtual void RemoveInterfaceActor(Actor* actor) = 0;
 
+	//Removes actors queued for destruction. Call through ActorSystemCache::FlushPendingRemoves().
+	virtual void FlushPendingRemoves() = 0;
+
 	virtual void CreateAllActorComponents() = 0;
 	virtual void Serialise(Serialiser& s) = 0;
 	virtual void SerialiseBinary(BinarySerialiser& s) = 0;
 	virtual void Deserialise(Deserialiser& s) = 0;
 	virtual void DeserialiseBinary(BinaryDeserialiser& s) = 0;
+
+	//Layout of the actor type's props, built from the first actor. Unbuilt while the system is empty.
+	virtual const PropsSchema& GetPropsSchema() = 0;
+
+	//Writes a PropsSchema header and one record per actor. The schema has to be recordable.
+	virtual void WriteRecords(PackedRecords& records) = 0;
+
+	//Reads records from WriteRecords() into the actors from firstIndex on.
+	virtual void ReadRecords(PackedRecords& records, uint32_t firstIndex) = 0;
+
+	//Same as above for a subset of the system's actors, e.g. the ones a delta save holds.
+	virtual void WriteRecords(PackedRecords& records, const std::vector<Actor*>& sources) = 0;
+	virtual void ReadRecords(PackedRecords& records, const std::vector<Actor*>& targets) = 0;
+
+	//One record without a header, e.g. to compare an actor against an earlier copy of itself.
+	virtual void WriteRecord(PackedRecords& records, Actor* source) = 0;
+
 	virtual void Cleanup() = 0;
 
+	//Takes every actor out of the system and its lookups without destroying them, see WorldCache.
+	//Reattach() puts them back, the system has to be empty by then.
+	virtual std::unique_ptr<DetachedSystem> Detach() = 0;
+	virtual void Reattach(std::unique_ptr<DetachedSystem> detached) = 0;
+
 protected:
 	std::string name;
 };
@@ -4,6 +4,7 @@
 #include "Core/Input.h"
 #include "Core/MeshSlicer.h"
 #include "Gameplay/IMeshSliceReaction.h"
+#include "Actors/ActorNameIndex.h"
 
 MeshSliceActor::MeshSliceActor()
 {
@@ -24,7 +25,7 @@ void MeshSliceActor::SliceMesh(XMVECTOR planeCenter, XMVECTOR planeNormal)
 {
 	sliceableMesh->SliceMesh(planeCenter, planeNormal);
 
-	auto actor = World::GetActorByNameAllowNull(linkedActor);
+	auto actor = ActorNameIndex::Find(linkedActor);
 	if (actor)
 	{
 		auto meshSliceReaction = dynamic_cast<IMeshSliceReaction*>(actor);
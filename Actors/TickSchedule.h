@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <DirectXMath.h>
+
+using namespace DirectX;
+
+//Optional per-Actor tick rate. The defaults tick every frame.
+struct TickSchedule
+{
+	//Seconds between ticks. deltaTime accumulated over skipped frames is passed to the next Tick().
+	float interval = 0.f;
+
+	//Distance LOD, measured from ActorTickScheduler::focusPosition. Inside lodNearDistance the actor
+	//ticks every frame, past it every lodFarFrameDivisor frames and past lodSleepDistance not at all.
+	//A distance of zero turns that part of the LOD off.
+	float lodNearDistance = 0.f;
+	float lodSleepDistance = 0.f;
+	uint32_t lodFarFrameDivisor = 4;
+
+	bool IsEveryFrame() const
+	{
+		return interval <= 0.f && lodNearDistance <= 0.f && lodSleepDistance <= 0.f;
+	}
+};
+
+enum class TickDecision
+{
+	Tick,
+	Skip,
+	Sleep
+};
+
+//Tick counts for an ActorSystem's last Tick(). Inactive and tick disabled actors aren't counted.
+struct ActorTickStats
+{
+	uint32_t ticked = 0;
+	uint32_t skipped = 0;
+	uint32_t asleep = 0;
+};
+
+//State shared by every ActorSystem's tick scheduling.
+struct ActorTickScheduler
+{
+	//Where distance LOD is measured from. Player sets this every frame.
+	inline static XMFLOAT3 focusPosition = XMFLOAT3(0.f, 0.f, 0.f);
+	inline static bool hasFocus = false;
+
+	//Battles need every actor at full rate. BattleSystem turns LOD off while a battle is active.
+	inline static bool lodEnabled = true;
+};
@@ -0,0 +1,106 @@
+#include "vpch.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include "Actors/Game/Grid.h"
+
+//Times ResetAllNodes() and a flood fill out from the middle of the grid through GetNeighbouringNodes(),
+//the same walk unit movement and range previews do, on 32x32, 128x128 and 512x512 grids.
+//Nodes are set up by hand in place of Grid::Awake(), which needs a renderer and physics to raycast against.
+//Grid's constructor still loads the node mesh, so run it from the game's working directory.
+
+using Clock = std::chrono::steady_clock;
+
+//Roughly the same work per size, so small grids aren't lost in timer noise.
+constexpr size_t nodesPerRun = 1 << 24;
+
+void SetupNodes(Grid& grid, int size)
+{
+	grid.sizeX = size;
+	grid.sizeY = size;
+
+	const size_t numNodes = static_cast<size_t>(size) * size;
+	grid.nodes.clear();
+	grid.nodes.reserve(numNodes);
+	grid.nodeHeights.clear();
+	grid.nodeHeights.reserve(numNodes);
+	grid.searchNodes.assign(numNodes, GridSearchNode());
+
+	for (int x = 0; x < size; x++)
+	{
+		for (int y = 0; y < size; y++)
+		{
+			GridNode node(x, y, static_cast<uint32_t>(grid.nodes.size()));
+
+			//Some obstacles and some ledges too high to step up, so neighbour checks don't all pass.
+			node.active = (x * 7 + y * 13) % 17 != 0;
+			node.worldPosition.y = (x / 4 + y / 4) % 5 == 0 ? 2.f : 0.f;
+
+			grid.nodes.push_back(node);
+			grid.nodeHeights.push_back(node.worldPosition.y);
+		}
+	}
+}
+
+double GetNanosecondsPerNode(Clock::time_point start, size_t numRuns, size_t numNodes)
+{
+	const double nanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+	return nanoseconds / static_cast<double>(numRuns * numNodes);
+}
+
+void RunSize(Grid& grid, int size)
+{
+	SetupNodes(grid, size);
+
+	const size_t numNodes = grid.nodes.size();
+	const size_t numRuns = std::max<size_t>(nodesPerRun / numNodes, 1);
+
+	Clock::time_point start = Clock::now();
+	for (size_t run = 0; run < numRuns; run++)
+	{
+		grid.ResetAllNodes();
+	}
+	const double resetNanoseconds = GetNanosecondsPerNode(start, numRuns, numNodes);
+
+	std::vector<GridNode*> open;
+	std::vector<GridNode*> neighbours;
+	size_t numReached = 0;
+
+	start = Clock::now();
+	for (size_t run = 0; run < numRuns; run++)
+	{
+		grid.ResetAllNodes();
+
+		GridNode* centerNode = grid.GetNode(size / 2, size / 2);
+		grid.GetSearchNode(centerNode).closed = true;
+
+		open.clear();
+		open.push_back(centerNode);
+
+		for (size_t openIndex = 0; openIndex < open.size(); openIndex++)
+		{
+			neighbours.clear();
+			grid.GetNeighbouringNodes(open[openIndex], neighbours);
+			open.insert(open.end(), neighbours.begin(), neighbours.end());
+		}
+
+		numReached = open.size();
+	}
+	const double floodNanoseconds = GetNanosecondsPerNode(start, numRuns, numNodes);
+
+	std::printf("%4dx%-4d ResetAllNodes() %6.2f ns/node  flood fill %6.2f ns/node (%zu of %zu nodes reached)\n",
+		size, size, resetNanoseconds, floodNanoseconds, numReached, numNodes);
+}
+
+int main()
+{
+	Grid* grid = Grid::system.Add();
+
+	for (const int size : { 32, 128, 512 })
+	{
+		RunSize(*grid, size);
+	}
+
+	return 0;
+}
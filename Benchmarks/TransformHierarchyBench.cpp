@@ -0,0 +1,154 @@
+#include "vpch.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+#include "Core/JobSystem.h"
+#include "Core/TransformHierarchy.h"
+#include "Components/EmptyComponent.h"
+
+//Compares the recursive SpatialComponent::UpdateTransform(parentWorld) walk the engine used to run every frame,
+//which rebuilt every world matrix whether it moved or not, against TransformHierarchy::Update() building only
+//the subtrees queued by transform setters. Both run over the same shape of hierarchy at 10k and 100k components,
+//with every actor moving, a tenth of them moving and none moving.
+
+using namespace DirectX;
+
+//Shaped like a typical actor, a root with four children and three of those with a child of their own.
+constexpr uint32_t componentsPerActor = 8;
+
+constexpr uint32_t warmupFrames = 5;
+constexpr uint32_t measuredFrames = 100;
+
+using Clock = std::chrono::steady_clock;
+
+//Components live in EmptyComponent::system, cleared with Cleanup() after each run.
+struct Hierarchy
+{
+	std::vector<SpatialComponent*> roots;
+};
+
+Hierarchy BuildHierarchy(uint32_t numComponents)
+{
+	Hierarchy hierarchy;
+
+	uint32_t numCreated = 0;
+	auto create = [&numCreated](float x) -> SpatialComponent* {
+		EmptyComponent* component = EmptyComponent::system.Add("BenchComponent" + std::to_string(numCreated++));
+		component->SetLocalPosition(x, 1.f, 0.f);
+		component->SetLocalRotation(XMQuaternionRotationRollPitchYaw(0.f, x * 0.01f, 0.f));
+		return component;
+	};
+
+	const uint32_t numActors = numComponents / componentsPerActor;
+	for (uint32_t actorIndex = 0; actorIndex < numActors; actorIndex++)
+	{
+		SpatialComponent* root = create(static_cast<float>(actorIndex));
+		hierarchy.roots.emplace_back(root);
+
+		for (uint32_t childIndex = 0; childIndex < 4; childIndex++)
+		{
+			SpatialComponent* child = create(static_cast<float>(childIndex));
+			root->AddChild(child);
+
+			if (childIndex < 3)
+			{
+				child->AddChild(create(0.5f));
+			}
+		}
+	}
+
+	//Everything was queued on creation, both runs start from a built hierarchy with nothing queued.
+	TransformHierarchy::Update();
+
+	return hierarchy;
+}
+
+//What SpatialComponent::UpdateTransform(parentWorld) did before world matrices were cached.
+void RecursiveUpdateTransform(SpatialComponent* component, XMMATRIX parentWorld)
+{
+	const XMMATRIX world = component->transform.GetAffine() * parentWorld;
+
+	for (SpatialComponent* child : component->GetChildren())
+	{
+		RecursiveUpdateTransform(child, world);
+	}
+
+	component->transform.world = world;
+}
+
+//Moves every moveStride'th actor through the setters, so both cases pay the same to flag and queue what moved,
+//then builds world matrices. Returns the average milliseconds per frame.
+template <typename UpdateFunc>
+double RunFrames(Hierarchy& hierarchy, uint32_t moveStride, UpdateFunc update)
+{
+	double totalMilliseconds = 0.0;
+
+	for (uint32_t frame = 0; frame < warmupFrames + measuredFrames; frame++)
+	{
+		const Clock::time_point start = Clock::now();
+
+		if (moveStride > 0)
+		{
+			const float offset = static_cast<float>(frame) * 0.01f;
+			for (size_t i = 0; i < hierarchy.roots.size(); i += moveStride)
+			{
+				hierarchy.roots[i]->SetLocalPosition(static_cast<float>(i), offset, 0.f);
+			}
+		}
+
+		update(hierarchy);
+
+		if (frame >= warmupFrames)
+		{
+			totalMilliseconds += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		}
+	}
+
+	return totalMilliseconds / measuredFrames;
+}
+
+void RunCase(uint32_t numComponents, uint32_t moveStride, const char* caseName)
+{
+	double recursiveMilliseconds = 0.0;
+	{
+		Hierarchy hierarchy = BuildHierarchy(numComponents);
+		recursiveMilliseconds = RunFrames(hierarchy, moveStride, [](Hierarchy& h) {
+			for (SpatialComponent* root : h.roots)
+			{
+				RecursiveUpdateTransform(root, XMMatrixIdentity());
+			}
+		});
+		EmptyComponent::system.Cleanup();
+	}
+
+	double passMilliseconds = 0.0;
+	uint32_t numBuilt = 0;
+	{
+		Hierarchy hierarchy = BuildHierarchy(numComponents);
+		passMilliseconds = RunFrames(hierarchy, moveStride, [](Hierarchy&) {
+			TransformHierarchy::Update();
+		});
+		numBuilt = TransformHierarchy::GetLastStats().numBuilt;
+		EmptyComponent::system.Cleanup();
+	}
+
+	std::printf("%7u components, %-12s recursive %8.3f ms  TransformHierarchy %8.3f ms (%u built a frame)\n",
+		numComponents, caseName, recursiveMilliseconds, passMilliseconds, numBuilt);
+}
+
+int main()
+{
+	JobSystem::Init();
+
+	for (const uint32_t numComponents : { 10000u, 100000u })
+	{
+		RunCase(numComponents, 1, "all moving");
+		RunCase(numComponents, 10, "10% moving");
+		RunCase(numComponents, 0, "none moving");
+	}
+
+	JobSystem::Shutdown();
+	return 0;
+}
@@ -8,6 +8,10 @@ class AudioComponent : public SpatialComponent
 public:
 	COMPONENT_SYSTEM(AudioComponent);
 
+	//Tick() only fades its own volume and pushes it to its own channel.
+	PARALLEL_TICK
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::Audio)
+
 	enum class FadeValue
 	{
 		None,
@@ -68,6 +68,14 @@ XMVECTOR BoxTriggerComponent::GetRandomPointInTrigger()
 	return XMLoadFloat3(&pos);
 }
 
+float BoxTriggerComponent::GetWorldBoundingRadius()
+{
+	XMVECTOR scale = GetWorldScaleV();
+	XMVECTOR center = XMLoadFloat3(&boundingBox.Center) * scale;
+	XMVECTOR extents = XMLoadFloat3(&boundingBox.Extents) * scale;
+	return XMVector3Length(center).m128_f32[0] + XMVector3Length(extents).m128_f32[0];
+}
+
 bool BoxTriggerComponent::IntersectsWithAnyBoundingBoxInWorld()
 {
 	for (auto& mesh : MeshComponent::system.GetComponents())
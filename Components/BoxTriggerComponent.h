@@ -10,6 +10,7 @@ class BoxTriggerComponent : public SpatialComponent
 {
 public:
 	COMPONENT_SYSTEM(BoxTriggerComponent)
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::None)
 
 	//default is green
 	XMFLOAT4 renderWireframeColour = XMFLOAT4(0.1f, 0.75f, 0.1f, 1.0f);
@@ -26,6 +27,9 @@ public:
 	void SetExtents(float x, float y, float z);
 	XMFLOAT3 GetExtents();
 
+	//Radius around the component's world position that holds the whole box at any rotation.
+	float GetWorldBoundingRadius();
+
 	bool QuickInPlaceBoxCast(HitResult& hitResult, bool drawDebug);
 
 	Actor* targetActor = nullptr;
@@ -9,6 +9,7 @@ class CameraComponent : public SpatialComponent
 {
 public:
 	COMPONENT_SYSTEM(CameraComponent)
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::None)
 
 	XMVECTOR focusPoint = XMVectorSet(0.f, 0.f, 0.f, 1.f);
 	Actor* targetActor = nullptr;
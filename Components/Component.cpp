@@ -2,30 +2,52 @@
 #include "Component.h"
 #include "IComponentSystem.h"
 #include "Core/Log.h"
-#include "Core/World.h"
+#include "Core/UIDIndex.h"
+#include "Actors/Actor.h"
 
 std::string Component::GetTypeName()
 {
 	return componentSystem->GetName();
 }
 
-void Component::AddTag(const std::string& tag)
+void Component::AddTag(Symbol tag)
 {
-	if (tags.find(tag) != tags.end())
+	auto tagIt = std::lower_bound(tags.begin(), tags.end(), tag);
+	if (tagIt != tags.end() && *tagIt == tag)
 	{
-		Log("Tag [%s] on Component [%s] already exists.", tag.c_str(), name.c_str());
+		Log("Tag [%s] on Component [%s] already exists.", tag.GetString().c_str(), name.c_str());
+		return;
 	}
 
-	tags.emplace(tag);
+	tags.insert(tagIt, tag);
 }
 
-bool Component::HasTag(const std::string& tag)
+bool Component::HasTag(Symbol tag)
 {
-	return tags.find(tag) != tags.end();
+	return std::binary_search(tags.begin(), tags.end(), tag);
+}
+
+void Component::SetUID(UID uid_)
+{
+	//Components outside of a system (e.g. ComponentSystem::Add() default arguments) aren't indexed.
+	if (componentSystem)
+	{
+		UIDIndex::RemoveComponent(this);
+		uid = uid_;
+		UIDIndex::AddComponent(this);
+		return;
+	}
+
+	uid = uid_;
 }
 
 Actor* Component::GetOwner()
 {
-	Actor* owner = World::GetActorByUID(ownerUID);
-	return owner;
+	Actor* ownerActor = owner.Get();
+	if (ownerActor == nullptr && ownerUID != 0)
+	{
+		ownerActor = UIDIndex::FindActor(ownerUID);
+	}
+
+	return ownerActor;
 }
@@ -2,7 +2,10 @@
 
 #include "Core/Properties.h"
 #include "Core/UID.h"
+#include "Core/Symbol.h"
+#include "Actors/ActorHandle.h"
 #include <set>
+#include <vector>
 
 class IComponentSystem;
 class Actor;
@@ -14,6 +17,11 @@ public:
 	virtual void Start() {}
 	virtual void Create() {};
 
+	//Called as the component's world is moved in and out of WorldCache. Release anything living outside
+	//the component that shouldn't stay around while the world isn't loaded (e.g. physics actors).
+	virtual void OnWorldSuspended() {}
+	virtual void OnWorldResumed() {}
+
 	//Remove the component from its parent ComponentSystem. Remove() is always defined in 
 	//COMPONENT_SYSTEM macro and doesn't need to be added explicity.
 	virtual void Remove() = 0;
@@ -40,8 +48,10 @@ public:
 	//Returns pruned typeid() name from linked Component System.
 	std::string GetTypeName();
 
-	void AddTag(const std::string& tag);
-	bool HasTag(const std::string& tag);
+	void AddTag(Symbol tag);
+	void AddTag(const std::string& tag) { AddTag(Symbol(tag)); }
+	bool HasTag(Symbol tag);
+	bool HasTag(const std::string& tag) { return HasTag(Symbol::Find(tag)); }
 
 	bool IsActive() { return active; }
 	void SetActive(bool newActive) { active = newActive; }
@@ -49,15 +59,24 @@ public:
 	int GetIndex() { return index; }
 	void SetIndex(int newIndex) { index = newIndex; }
 
+	IComponentSystem* GetComponentSystem() { return componentSystem; }
 	void SetComponentSystem(IComponentSystem* componentSystem_) { componentSystem = componentSystem_; }
 
+	//Slot and generation issued by the ComponentSystem. Use ComponentHandle<> instead of reading these directly.
+	uint32_t GetHandleSlot() { return handleSlot; }
+	uint32_t GetHandleGeneration() { return handleGeneration; }
+	void SetHandle(const uint32_t slot, const uint32_t generation) { handleSlot = slot; handleGeneration = generation; }
+
 	UID GetUID() { return uid; }
-	void SetUID(UID uid_) { uid = uid_; }
+	void SetUID(UID uid_);
 
 	UID GetOwnerUID() { return ownerUID; }
 	void SetOwnerUID(UID ownerUID_) { ownerUID = ownerUID_; }
 
+	//Set from Actor::AddComponent(). Falls back to a UID lookup if the owner handle isn't set.
 	Actor* GetOwner();
+	void SetOwner(Actor* owner_) { owner.Set(owner_); }
+	bool HasOwnerLink() const { return static_cast<bool>(owner); }
 
 	bool IsTickEnabled() { return tickEnabled; }
 	void SetTickEnabled(bool newTickState) { tickEnabled = newTickState; }
@@ -73,11 +92,14 @@ public:
 	std::string name;
 
 private:
-	std::set<std::string> tags;
+	std::vector<Symbol> tags; //Sorted
 	IComponentSystem* componentSystem = nullptr;
+	ActorHandle<Actor> owner;
 	UID uid = GenerateUID();
 	UID ownerUID = 0; //Keep as zero to denote component that doesn't have an owner.
 	int index = -1;
+	uint32_t handleSlot = 0;
+	uint32_t handleGeneration = 0;
 	bool active = true;
 	bool visible = true;
 	bool tickEnabled = true;
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include "IComponentSystem.h"
+
+class Component;
+
+//Weak reference to a Component, issued by the component's ComponentSystem.
+//Get() returns nullptr once the component has been removed instead of dangling like a raw pointer.
+template <typename T = Component>
+class ComponentHandle
+{
+public:
+	ComponentHandle() {}
+	ComponentHandle(T* component) { Set(component); }
+
+	void Set(T* component)
+	{
+		if (component == nullptr)
+		{
+			Reset();
+			return;
+		}
+
+		system = component->GetComponentSystem();
+		slot = component->GetHandleSlot();
+		generation = component->GetHandleGeneration();
+	}
+
+	T* Get() const
+	{
+		if (system == nullptr)
+		{
+			return nullptr;
+		}
+
+		return static_cast<T*>(system->ResolveHandle(slot, generation));
+	}
+
+	void Reset()
+	{
+		system = nullptr;
+		slot = 0;
+		generation = 0;
+	}
+
+	T* operator->() const { return Get(); }
+	explicit operator bool() const { return Get() != nullptr; }
+
+	bool operator==(const ComponentHandle& other) const
+	{
+		return system == other.system && slot == other.slot && generation == other.generation;
+	}
+
+private:
+	IComponentSystem* system = nullptr;
+	uint32_t slot = 0;
+	uint32_t generation = 0;
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <bitset>
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+//Add inside a component class to have its ComponentSystem allocate from a ComponentPool
+//instead of individual heap allocations. Derived component types inherit the storage mode.
+#define POOLED_COMPONENT_STORAGE inline static constexpr bool pooledStorage = true;
+
+template <typename T>
+concept PooledComponentStorage = requires { requires T::pooledStorage; };
+
+//Fixed size pages of components with a free list. Addresses stay stable for a component's
+//lifetime (ComponentSystem and everything else hands out raw pointers) and iterating with
+//ForEach() walks the pages linearly instead of chasing one heap pointer per component.
+template <typename T>
+class ComponentPool
+{
+public:
+	//Aim for 64KB pages but keep at least 16 components per page for the larger types.
+	static constexpr size_t GetPageCapacity()
+	{
+		return std::max<size_t>(16, (64 * 1024) / sizeof(T));
+	}
+
+	template <typename... Args>
+	T* Create(Args&&... args)
+	{
+		if (freeSlots.empty())
+		{
+			AddPage();
+		}
+
+		const Slot slot = freeSlots.back();
+		freeSlots.pop_back();
+
+		Page& page = *pages[slot.page];
+		T* component = new (page.Get(slot.index)) T(std::forward<Args>(args)...);
+		page.live.set(slot.index);
+		numLive++;
+
+		return component;
+	}
+
+	void Destroy(T* component)
+	{
+		Cell* cell = Cell::FromComponent(component);
+		Page& page = *pages[cell->page];
+		assert(page.live.test(cell->index) && "Component destroyed twice in ComponentPool.");
+
+		component->~T();
+		page.live.reset(cell->index);
+		numLive--;
+
+		freeSlots.emplace_back(Slot{ cell->page, cell->index });
+	}
+
+	//Visits every live component in memory order. Components created or destroyed
+	//during iteration are safe, they're picked up or skipped depending on their slot.
+	template <typename Func>
+	void ForEach(Func func)
+	{
+		ForEachInPages(0, GetNumPages(), func);
+	}
+
+	//Same as ForEach() over a range of pages. Used to split pooled systems across the JobSystem.
+	template <typename Func>
+	void ForEachInPages(uint32_t pageBegin, uint32_t pageEnd, Func func)
+	{
+		for (uint32_t pageIndex = pageBegin; pageIndex < pageEnd && pageIndex < pages.size(); pageIndex++)
+		{
+			Page& page = *pages[pageIndex];
+			if (page.live.none())
+			{
+				continue;
+			}
+
+			for (uint32_t slotIndex = 0; slotIndex < GetPageCapacity(); slotIndex++)
+			{
+				if (page.live.test(slotIndex))
+				{
+					func(page.Get(slotIndex));
+				}
+			}
+		}
+	}
+
+	size_t GetNumLive() { return numLive; }
+	uint32_t GetNumPages() { return static_cast<uint32_t>(pages.size()); }
+
+	//Frees all pages. Every component has to have been destroyed already (ComponentSystem::Cleanup()).
+	void ReleasePages()
+	{
+		assert(numLive == 0);
+		pages.clear();
+		freeSlots.clear();
+	}
+
+private:
+	//Each component is prefixed with its location so Destroy() doesn't have to search the pages.
+	struct Cell
+	{
+		uint32_t page = 0;
+		uint32_t index = 0;
+		alignas(T) std::byte object[sizeof(T)];
+
+		static Cell* FromComponent(T* component)
+		{
+			return reinterpret_cast<Cell*>(reinterpret_cast<std::byte*>(component) - offsetof(Cell, object));
+		}
+	};
+
+	struct Page
+	{
+		Cell cells[GetPageCapacity()];
+		std::bitset<GetPageCapacity()> live;
+
+		T* Get(uint32_t index)
+		{
+			return reinterpret_cast<T*>(cells[index].object);
+		}
+	};
+
+	struct Slot
+	{
+		uint32_t page = 0;
+		uint32_t index = 0;
+	};
+
+	void AddPage()
+	{
+		const uint32_t pageIndex = static_cast<uint32_t>(pages.size());
+		pages.emplace_back(std::make_unique<Page>());
+
+		Page& page = *pages.back();
+		for (uint32_t slotIndex = 0; slotIndex < GetPageCapacity(); slotIndex++)
+		{
+			page.cells[slotIndex].page = pageIndex;
+			page.cells[slotIndex].index = slotIndex;
+		}
+
+		//Push in reverse so slots are handed out front to back within the page.
+		for (uint32_t slotIndex = GetPageCapacity(); slotIndex > 0; slotIndex--)
+		{
+			freeSlots.emplace_back(Slot{ pageIndex, slotIndex - 1 });
+		}
+	}
+
+	std::vector<std::unique_ptr<Page>> pages;
+	std::vector<Slot> freeSlots;
+	size_t numLive = 0;
+};
+
+//unique_ptr deleter for ComponentSystem's storage. Returns pooled components to their
+//ComponentPool, otherwise behaves like std::default_delete.
+template <typename T>
+struct ComponentDeleter
+{
+	ComponentPool<T>* pool = nullptr;
+
+	void operator()(T* component) const
+	{
+		if (pool)
+		{
+			pool->Destroy(component);
+		}
+		else
+		{
+			delete component;
+		}
+	}
+};
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <vector>
+#include <memory>
+#include <unordered_map>
 #include "IComponentSystem.h"
+#include "ComponentPool.h"
 #include "Core/SystemStates.h"
 #include "Actors/Actor.h"
 #include "ComponentSystemCache.h"
@@ -9,29 +12,58 @@
 #include "Core/VString.h"
 #include "Editor/Editor.h"
 #include "Core/World.h"
+#include "Core/HandleTable.h"
+#include "Core/PropsSchema.h"
+#include "Core/JobSystem.h"
+#include "Core/SystemAccess.h"
+#include "Core/SystemProfiler.h"
+#include "Core/UIDIndex.h"
+#include "Core/WorldCache.h"
 
 template <typename T>
 class ComponentSystem : public IComponentSystem
 {
 public:
+	using ComponentPtr = std::unique_ptr<T, ComponentDeleter<T>>;
+
 	ComponentSystem()
 	{
 		std::string typeName = typeid(T).name();
 		std::string token = typeName.substr(typeName.find(" ") + 1);
 		name = token;
+		typeID = numSystemTypes++;
 
 		ComponentSystemCache::Get().Add(typeid(T), this);
 	}
 
 	T* Add(std::string name, Actor* owner = nullptr, T newComponent = T(), bool callCreate = false)
 	{
-		components.emplace_back(std::make_unique<T>(std::move(newComponent)));
+		if constexpr (PooledComponentStorage<T>)
+		{
+			components.emplace_back(pool.Create(std::move(newComponent)), ComponentDeleter<T>{ &pool });
+		}
+		else
+		{
+			components.emplace_back(new T(std::move(newComponent)), ComponentDeleter<T>{});
+		}
+
 		auto& component = components.back();
 
 		component->SetIndex(components.size() - 1);
 		component->SetComponentSystem(this);
 		component->name = name;
 
+		//emplace() keeps an existing entry if the name is already taken.
+		if (!nameIndexDirty)
+		{
+			componentsByName.emplace(name, component.get());
+		}
+
+		const uint32_t handleSlot = handles.Issue(component->GetIndex());
+		component->SetHandle(handleSlot, handles.GetGeneration(handleSlot));
+
+		UIDIndex::AddComponent(component.get());
+
 		if (systemState == SystemStates::Loaded && callCreate)
 		{
 			component->Create();
@@ -45,11 +77,28 @@ public:
 		return component.get();
 	}
 
-	std::vector<std::unique_ptr<T>>& GetComponents()
+	std::vector<ComponentPtr>& GetComponents()
 	{
 		return components;
 	}
 
+	//Prefer this over GetComponents() for full passes, pooled systems walk their pages linearly.
+	template <typename Func>
+	void ForEachComponent(Func func)
+	{
+		if constexpr (PooledComponentStorage<T>)
+		{
+			pool.ForEach(func);
+		}
+		else
+		{
+			for (auto& component : components)
+			{
+				func(component.get());
+			}
+		}
+	}
+
 	virtual Component* SpawnComponent(Actor* owner) override
 	{
 		return (Component*)Add("", owner);
@@ -57,15 +106,27 @@ public:
 
 	void Remove(int index)
 	{
+		PROFILE_SYSTEM(name, Remove, 1);
+
 		std::swap(components[index], components.back());
 		components[index]->SetIndex(index);
+		handles.SetIndex(components[index]->GetHandleSlot(), index);
+		handles.Release(components.back()->GetHandleSlot());
 
-		if (components.back()->GetOwnerUID() != 0)
+		Actor* owner = components.back()->GetOwner();
+		if (owner)
 		{
-			auto owner = World::GetActorByUID(components.back()->GetOwnerUID());
 			owner->RemoveComponent(components.back().get());
 		}
 
+		//Another component might share the name, rebuild on the next lookup to find it.
+		auto nameIt = componentsByName.find(components.back()->name);
+		if (nameIt != componentsByName.end() && nameIt->second == components.back().get())
+		{
+			nameIndexDirty = true;
+		}
+
+		UIDIndex::RemoveComponent(components.back().get());
 		components.pop_back();
 
 		//Make sure the Properties Dock is reset else you'll have widgets trying to access invalid pointers to components.
@@ -74,16 +135,23 @@ public:
 
 	virtual void Init() override
 	{
+		PROFILE_SYSTEM(name, Init, components.size());
+
 		for (auto& component : components)
 		{
 			component->Create();
 		}
 
+		//Names can be assigned directly while a world is being loaded in.
+		nameIndexDirty = true;
+
 		systemState = SystemStates::Loaded;
 	}
 
 	virtual void Start() override
 	{
+		PROFILE_SYSTEM(name, Start, components.size());
+
 		for (auto& component : components)
 		{
 			component->Start();
@@ -92,15 +160,59 @@ public:
 
 	virtual void Tick(float deltaTime) override
 	{
-		for (int i = 0; i < components.size(); i++)
+		PROFILE_SYSTEM(name, Tick, components.size());
+
+		auto TickComponent = [deltaTime](T* component) {
+			if (component->IsActive() && component->IsTickEnabled())
+			{
+				component->Tick(deltaTime);
+			}
+		};
+
+		if constexpr (ParallelTickSafe<T>)
+		{
+			//Pooled systems split by page, the rest by ranges of the components vector.
+			if constexpr (PooledComponentStorage<T>)
+			{
+				JobSystem::ParallelFor(pool.GetNumPages(), 1, [&](uint32_t begin, uint32_t end) {
+					pool.ForEachInPages(begin, end, TickComponent);
+				});
+			}
+			else
+			{
+				JobSystem::ParallelFor(static_cast<uint32_t>(components.size()), parallelTickGrainSize, [&](uint32_t begin, uint32_t end) {
+					for (uint32_t i = begin; i < end; i++)
+					{
+						TickComponent(components[i].get());
+					}
+				});
+			}
+		}
+		else if constexpr (PooledComponentStorage<T>)
+		{
+			pool.ForEach(TickComponent);
+		}
+		else
 		{
-			if (components[i]->IsActive() && components[i]->IsTickEnabled())
+			for (int i = 0; i < components.size(); i++)
 			{
-				components[i]->Tick(deltaTime);
+				TickComponent(components[i].get());
 			}
 		}
 	}
 
+	virtual SystemAccess GetAccess() override
+	{
+		if constexpr (DeclaresSystemAccess<T>)
+		{
+			return T::systemAccess;
+		}
+		else
+		{
+			return SystemAccess();
+		}
+	}
+
 	T* GetFirstComponent()
 	{
 		return components.front().get();
@@ -113,32 +225,43 @@ public:
 
 	T* GetComponentByUID(UID uid)
 	{
-		for (auto& component : components)
+		Component* component = UIDIndex::FindComponent(uid);
+		if (component && component->GetComponentSystem() == this)
 		{
-			if (component->GetUID() == uid)
-			{
-				return component.get();
-			}
+			return static_cast<T*>(component);
 		}
 
 		return nullptr;
 	}
 
+	//Component names aren't unique in a system, if several share a name one of them is returned.
 	T* GetComponentByName(std::string name)
 	{
-		for (auto& component : components)
+		if (nameIndexDirty)
 		{
-			if (component->name == name)
-			{
-				return component.get();
-			}
+			RebuildNameIndex();
 		}
 
-		return nullptr;
+		auto nameIt = componentsByName.find(name);
+		if (nameIt == componentsByName.end())
+		{
+			return nullptr;
+		}
+
+		//Catch a name changed behind the index's back.
+		if (nameIt->second->name != name)
+		{
+			RebuildNameIndex();
+			return GetComponentByName(name);
+		}
+
+		return nameIt->second;
 	}
 
 	virtual void Serialise(Serialiser& s) override
 	{
+		PROFILE_SYSTEM(name, Serialise, components.size());
+
 		s.WriteLine(VString::stows(name));
 		s.WriteLine(components.size());
 
@@ -156,16 +279,33 @@ public:
 
 	virtual void SerialiseBinary(BinarySerialiser& s) override
 	{
+		PROFILE_SYSTEM(name, Serialise, components.size());
+
 		s.WriteString(name);
 		size_t numComponents = components.size();
 		s.Write(&numComponents);
 
+		//Owners and names up front so components can be spawned onto their owners before DeserialiseBinary().
 		for (auto& component : components)
 		{
 			UID ownerUID = component->GetOwnerUID();
 			s.Write(&ownerUID);
 			s.WriteString(component->name);
+		}
+
+		const bool packedRecords = GetPropsSchema().IsRecordable();
+		s.Write(&packedRecords);
+
+		if (packedRecords)
+		{
+			PackedRecords records;
+			WriteRecords(records);
+			s.WriteString(records.GetBytes());
+			return;
+		}
 
+		for (auto& component : components)
+		{
 			auto props = component->GetProps();
 			s.Serialise(props);
 		}
@@ -173,25 +313,129 @@ public:
 
 	virtual void Deserialise(Deserialiser& d) override
 	{
+		PROFILE_SYSTEM(name, Deserialise, components.size());
+
 		for (auto& component : components)
 		{
+			//UID is a property, reindex once it's been read in.
+			UIDIndex::RemoveComponent(component.get());
 			auto props = component->GetProps();
 			d.Deserialise(props);
+			UIDIndex::AddComponent(component.get());
 		}
 	}
 
 	virtual void DeserialiseBinary(BinaryDeserialiser& d) override
 	{
+		PROFILE_SYSTEM(name, Deserialise, components.size());
+
+		bool packedRecords = false;
+		d.Read(&packedRecords);
+
+		if (packedRecords)
+		{
+			std::string recordBytes;
+			d.ReadString(recordBytes);
+			PackedRecords records(std::move(recordBytes));
+			ReadRecords(records, GetComponentsAsBaseClass());
+			return;
+		}
+
 		for (auto& component : components)
 		{
+			//UID is a property, reindex once it's been read in.
+			UIDIndex::RemoveComponent(component.get());
 			auto props = component->GetProps();
 			d.Deserialise(props);
+			UIDIndex::AddComponent(component.get());
+		}
+	}
+
+	virtual const PropsSchema& GetPropsSchema() override
+	{
+		BuildPropsSchema();
+		return propsSchema;
+	}
+
+	virtual void WriteRecords(PackedRecords& records) override
+	{
+		BuildPropsSchema();
+		assert(propsSchema.IsRecordable());
+
+		propsSchema.WriteHeader(records);
+
+		for (auto& component : components)
+		{
+			WriteRecord(records, *component);
+		}
+	}
+
+	virtual void WriteRecords(PackedRecords& records, const std::vector<Component*>& sources) override
+	{
+		BuildPropsSchema();
+		assert(propsSchema.IsRecordable());
+
+		propsSchema.WriteHeader(records);
+
+		for (Component* source : sources)
+		{
+			assert(source->GetComponentSystem() == this);
+			WriteRecord(records, *static_cast<T*>(source));
+		}
+	}
+
+	virtual void WriteRecord(PackedRecords& records, Component* source) override
+	{
+		BuildPropsSchema();
+		assert(source->GetComponentSystem() == this);
+		WriteRecord(records, *static_cast<T*>(source));
+	}
+
+	virtual void ReadRecords(PackedRecords& records, const std::vector<Component*>& targets) override
+	{
+		BuildPropsSchema();
+		const PropsSchema::FileLayout layout = propsSchema.ReadHeader(records);
+
+		for (Component* target : targets)
+		{
+			assert(target->GetComponentSystem() == this);
+			T* component = static_cast<T*>(target);
+
+			//UID is in the records, reindex once it's been read in.
+			UIDIndex::RemoveComponent(component);
+
+			if (propsSchema.IsValid())
+			{
+				void* base = component;
+				propsSchema.ReadRecord(records, &base, layout);
+			}
+			else
+			{
+				auto props = component->GetProps();
+				PropsSchema::ReadRecordIntoProps(records, layout, props);
+			}
+
+			UIDIndex::AddComponent(component);
 		}
 	}
 
 	virtual void Cleanup() override
 	{
+		ForEachComponent([](T* component) {
+			UIDIndex::RemoveComponent(component);
+		});
+
+		handles.ReleaseAll();
 		components.clear();
+
+		componentsByName.clear();
+		nameIndexDirty = false;
+
+		if constexpr (PooledComponentStorage<T>)
+		{
+			pool.ReleasePages();
+		}
+
 		systemState = SystemStates::Unloaded;
 	}
 
@@ -212,19 +456,159 @@ public:
 
 	virtual Component* FindComponentByName(std::string componentName) override
 	{
-		for (auto& component : components)
+		return (Component*)GetComponentByName(componentName);
+	}
+
+	virtual Component* ResolveHandle(uint32_t slot, uint32_t generation) override
+	{
+		const int index = handles.Resolve(slot, generation);
+		if (index < 0)
+		{
+			return nullptr;
+		}
+
+		return components[index].get();
+	}
+
+	virtual void RelinkComponentsToOwners() override
+	{
+		ForEachComponent([](T* component) {
+			if (component->GetOwnerUID() != 0 && !component->HasOwnerLink())
+			{
+				Actor* owner = UIDIndex::FindActor(component->GetOwnerUID());
+				if (owner)
+				{
+					owner->AddComponent(component);
+				}
+			}
+		});
+	}
+
+	virtual std::unique_ptr<DetachedSystem> Detach() override
+	{
+		ForEachComponent([](T* component) {
+			UIDIndex::RemoveComponent(component);
+		});
+
+		auto detached = std::make_unique<DetachedComponents>();
+
+		//Pooled components go with their pages, deleters are pointed at wherever the pool lives now.
+		if constexpr (PooledComponentStorage<T>)
 		{
-			if (component->name == componentName)
+			detached->pool = std::make_unique<ComponentPool<T>>(std::move(pool));
+			pool = ComponentPool<T>();
+
+			for (auto& component : components)
 			{
-				return (Component*)component.get();
+				component.get_deleter().pool = detached->pool.get();
 			}
 		}
 
-		return nullptr;
+		detached->components = std::move(components);
+		detached->handles = std::move(handles);
+
+		components.clear();
+		//Generations are unique across tables, stale handles from the detached world won't resolve to new objects.
+		handles = HandleTable();
+		componentsByName.clear();
+		nameIndexDirty = false;
+		systemState = SystemStates::Unloaded;
+
+		return detached;
+	}
+
+	virtual void Reattach(std::unique_ptr<DetachedSystem> detachedSystem) override
+	{
+		assert(components.empty());
+
+		auto& detached = static_cast<DetachedComponents&>(*detachedSystem);
+
+		if constexpr (PooledComponentStorage<T>)
+		{
+			pool = std::move(*detached.pool);
+
+			for (auto& component : detached.components)
+			{
+				component.get_deleter().pool = &pool;
+			}
+		}
+
+		components = std::move(detached.components);
+		handles = std::move(detached.handles);
+		nameIndexDirty = true;
+		systemState = SystemStates::Loaded;
+
+		ForEachComponent([](T* component) {
+			UIDIndex::AddComponent(component);
+		});
 	}
 
 private:
-	std::vector<std::unique_ptr<T>> components;
+	struct DetachedComponents : DetachedSystem
+	{
+		//Declared before components so it outlives their deleters.
+		std::unique_ptr<ComponentPool<T>> pool;
+		std::vector<ComponentPtr> components;
+		HandleTable handles;
+
+		virtual size_t GetMemorySize() const override { return components.size() * sizeof(T); }
+	};
+
+	//Every component of T has the same props layout, so the first one's GetProps() stands in for all of them.
+	void BuildPropsSchema()
+	{
+		if (propsSchema.IsBuilt() || components.empty())
+		{
+			return;
+		}
+
+		T& component = *components.front();
+		auto props = component.GetProps();
+		const PropsSchema::Base base = { &component, sizeof(T) };
+		propsSchema.Build(props, &base, 1);
+	}
+
+	void WriteRecord(PackedRecords& records, T& component)
+	{
+		if (propsSchema.IsValid())
+		{
+			void* base = &component;
+			propsSchema.WriteRecord(records, &base);
+		}
+		else
+		{
+			auto props = component.GetProps();
+			propsSchema.WriteRecordFromProps(records, props);
+		}
+	}
+
+	void RebuildNameIndex()
+	{
+		componentsByName.clear();
+		componentsByName.reserve(components.size());
+
+		for (auto& component : components)
+		{
+			componentsByName.emplace(component->name, component.get());
+		}
+
+		nameIndexDirty = false;
+	}
+
+	//Number of components handed to each job when T is marked with PARALLEL_TICK.
+	static constexpr uint32_t parallelTickGrainSize = 64;
+
+	//Only used when T is marked with POOLED_COMPONENT_STORAGE.
+	//Declared before components so it outlives their deleters on static destruction.
+	ComponentPool<T> pool;
+
+	std::vector<ComponentPtr> components;
+	HandleTable handles;
+	PropsSchema propsSchema;
+
+	//One component per name, see GetComponentByName().
+	std::unordered_map<std::string, T*> componentsByName;
+	bool nameIndexDirty = false;
 };
 
 #define COMPONENT_SYSTEM(type) \
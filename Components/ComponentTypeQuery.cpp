@@ -0,0 +1,74 @@
+#include "vpch.h"
+#include "ComponentTypeQuery.h"
+#include <vector>
+#include <cassert>
+#include <bit>
+#include "Component.h"
+#include "IComponentSystem.h"
+
+static std::vector<bool(*)(Component*)> queryIsAFuncs;
+
+//Per component system type ID, which query bits have been checked and which of those matched.
+static std::vector<uint64_t> checkedQueryMasks;
+static std::vector<uint64_t> matchedQueryMasks;
+
+static uint32_t registryVersion = 0;
+
+uint32_t ComponentQueryRegistry::Register(IsAFunc isA)
+{
+	assert(queryIsAFuncs.size() < maxQueryTypes && "Too many component query types, raise maxQueryTypes.");
+
+	queryIsAFuncs.emplace_back(isA);
+	registryVersion++;
+
+	return static_cast<uint32_t>(queryIsAFuncs.size() - 1);
+}
+
+uint64_t ComponentQueryRegistry::GetMatchMask(Component* component)
+{
+	const uint64_t allQueriesMask = queryIsAFuncs.size() == maxQueryTypes ?
+		UINT64_MAX : (1ull << queryIsAFuncs.size()) - 1;
+
+	IComponentSystem* componentSystem = component->GetComponentSystem();
+	if (componentSystem == nullptr)
+	{
+		uint64_t matchMask = 0;
+		for (uint32_t queryID = 0; queryID < queryIsAFuncs.size(); queryID++)
+		{
+			if (queryIsAFuncs[queryID](component))
+			{
+				matchMask |= 1ull << queryID;
+			}
+		}
+		return matchMask;
+	}
+
+	const uint32_t typeID = componentSystem->GetTypeID();
+	if (typeID >= checkedQueryMasks.size())
+	{
+		checkedQueryMasks.resize(typeID + 1, 0);
+		matchedQueryMasks.resize(typeID + 1, 0);
+	}
+
+	//Only query types registered since this system's type was last seen need a cast
+	uint64_t uncheckedMask = allQueriesMask & ~checkedQueryMasks[typeID];
+	while (uncheckedMask)
+	{
+		const uint32_t queryID = static_cast<uint32_t>(std::countr_zero(uncheckedMask));
+		uncheckedMask &= uncheckedMask - 1;
+
+		if (queryIsAFuncs[queryID](component))
+		{
+			matchedQueryMasks[typeID] |= 1ull << queryID;
+		}
+
+		checkedQueryMasks[typeID] |= 1ull << queryID;
+	}
+
+	return matchedQueryMasks[typeID];
+}
+
+uint32_t ComponentQueryRegistry::GetVersion()
+{
+	return registryVersion;
+}
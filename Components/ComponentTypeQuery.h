@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+class Component;
+
+//Dense IDs for component types used in Actor::GetComponentsOfType<T>() queries.
+//Whether a component system's type is-a query type (respecting inheritance, so a MeshComponent query
+//also matches InstanceMeshComponent) is worked out with one dynamic_cast per system and query type, then cached.
+class ComponentQueryRegistry
+{
+public:
+	static constexpr uint32_t maxQueryTypes = 64;
+
+	template <typename T>
+	static uint32_t GetQueryID()
+	{
+		static const uint32_t queryID = Register([](Component* component) {
+			return dynamic_cast<T*>(component) != nullptr;
+		});
+		return queryID;
+	}
+
+	//Bit per registered query type that the component matches.
+	static uint64_t GetMatchMask(Component* component);
+
+	//Bumped every time a new query type registers, actors rebuild their type index when it changes.
+	static uint32_t GetVersion();
+
+private:
+	using IsAFunc = bool(*)(Component*);
+
+	static uint32_t Register(IsAFunc isA);
+};
+
+struct TypedComponentEntry
+{
+	uint32_t queryID = 0;
+	Component* component = nullptr;
+};
+
+//Non-owning range over an actor's components of type T. Invalidated by adding or removing components on the actor.
+template <typename T>
+class ComponentTypeView
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(const TypedComponentEntry* entry_) : entry(entry_) {}
+
+		T* operator*() const { return static_cast<T*>(entry->component); }
+		Iterator& operator++() { entry++; return *this; }
+		bool operator==(const Iterator& other) const { return entry == other.entry; }
+		bool operator!=(const Iterator& other) const { return entry != other.entry; }
+
+	private:
+		const TypedComponentEntry* entry;
+	};
+
+	ComponentTypeView() {}
+	ComponentTypeView(const TypedComponentEntry* first_, const TypedComponentEntry* last_) : first(first_), last(last_) {}
+
+	Iterator begin() const { return Iterator(first); }
+	Iterator end() const { return Iterator(last); }
+
+	size_t size() const { return static_cast<size_t>(last - first); }
+	bool empty() const { return first == last; }
+
+	T* operator[](size_t index) const { return static_cast<T*>(first[index].component); }
+	T* front() const { return static_cast<T*>(first->component); }
+
+private:
+	const TypedComponentEntry* first = nullptr;
+	const TypedComponentEntry* last = nullptr;
+};
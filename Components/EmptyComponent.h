@@ -8,6 +8,8 @@ class EmptyComponent : public SpatialComponent
 {
 public:
 	COMPONENT_SYSTEM(EmptyComponent);
+	POOLED_COMPONENT_STORAGE
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::None)
 
 	EmptyComponent() {}
 	virtual Properties GetProps() override;
@@ -1,6 +1,7 @@
 #include "vpch.h"
 #include "DialogueComponent.h"
-#include "Core/World.h"
+#include "Actors/Actor.h"
+#include "Actors/ActorNameIndex.h"
 #include "Components/WidgetComponent.h"
 #include "UI/Widget.h"
 #include "UI/UISystem.h"
@@ -105,7 +106,7 @@ bool DialogueComponent::ShowTextAtActor()
         return false;
     }
 
-    Actor* actor = World::GetActorByNameAllowNull(VString::wstos(dataIt->second.actorName));
+    Actor* actor = ActorNameIndex::Find(VString::wstos(dataIt->second.actorName));
     if (actor == nullptr)
     {
         Log("Dialogue actor [%s] not found at line [%d]", dataIt->second.actorName.c_str(), currentLine);
@@ -182,7 +183,7 @@ void DialogueComponent::ConversationShowTextAtActor()
         return;
     }
 
-    Actor* actor = World::GetActorByNameAllowNull(VString::wstos(dataIt->second.actorName));
+    Actor* actor = ActorNameIndex::Find(VString::wstos(dataIt->second.actorName));
     if (actor == nullptr)
     {
         Log("Dialogue actor [%s] not found at line [%d]", dataIt->second.actorName.c_str(), currentLine);
@@ -8,6 +8,7 @@ struct DialogueWidget;
 struct DialogueComponent : WidgetComponent
 {
 	COMPONENT_SYSTEM(DialogueComponent)
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::None)
 
 private:
 	int currentLine = 0;
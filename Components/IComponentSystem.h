@@ -1,10 +1,15 @@
 #pragma once
 
 #include "Core/SystemStates.h"
+#include "Core/SystemAccess.h"
 #include <string>
+#include <memory>
 
 class Component;
 class Actor;
+class DetachedSystem;
+class PropsSchema;
+class PackedRecords;
 class Serialiser;
 class BinarySerialiser;
 class Deserialiser;
@@ -15,20 +20,56 @@ class IComponentSystem
 public:
 	virtual void Init() = 0;
 	virtual void Tick(float deltaTime) = 0;
+
+	//What Tick() reads and writes, for SystemScheduler. Declared with SYSTEM_ACCESS() on the component type.
+	virtual SystemAccess GetAccess() = 0;
 	virtual void Start() = 0;
 	virtual void Cleanup() = 0;
 	virtual void Serialise(Serialiser& s) = 0;
 	virtual void SerialiseBinary(BinarySerialiser& s) = 0;
 	virtual void Deserialise(Deserialiser& s) = 0;
 	virtual void DeserialiseBinary(BinaryDeserialiser& d) = 0;
+
+	//Layout of the component type's props, built from the first component. Unbuilt while the system is empty.
+	virtual const PropsSchema& GetPropsSchema() = 0;
+
+	//Writes a PropsSchema header and one record per component. The schema has to be recordable.
+	virtual void WriteRecords(PackedRecords& records) = 0;
+
+	//Same as above for a subset of the system's components, e.g. the ones a delta save holds.
+	virtual void WriteRecords(PackedRecords& records, const std::vector<Component*>& sources) = 0;
+
+	//One record without a header, e.g. to compare a component against an earlier copy of itself.
+	virtual void WriteRecord(PackedRecords& records, Component* source) = 0;
+
+	//Reads records from WriteRecords() into targets, which all have to be in this system.
+	virtual void ReadRecords(PackedRecords& records, const std::vector<Component*>& targets) = 0;
+
 	virtual Component* SpawnComponent(Actor* owner) = 0;
 	virtual std::vector<Component*> GetComponentsAsBaseClass() = 0;
 	virtual uint32_t GetNumComponents() = 0;
 	virtual Component* FindComponentByName(std::string componentName) = 0;
 
+	//Returns the component a ComponentHandle refers to, or nullptr if it has since been removed.
+	virtual Component* ResolveHandle(uint32_t slot, uint32_t generation) = 0;
+
+	//Adds components to their owner actors by owner UID after a load. See UIDIndex::RelinkAllComponentsToOwners().
+	virtual void RelinkComponentsToOwners() = 0;
+
+	//Takes every component out of the system and its lookups without destroying them, see WorldCache.
+	//Reattach() puts them back, the system has to be empty by then.
+	virtual std::unique_ptr<DetachedSystem> Detach() = 0;
+	virtual void Reattach(std::unique_ptr<DetachedSystem> detached) = 0;
+
 	auto GetName() { return name; }
 
+	//Dense ID per component system, see ComponentQueryRegistry.
+	uint32_t GetTypeID() { return typeID; }
+
 protected:
 	SystemStates systemState = SystemStates::Unloaded;
 	std::string name;
+	uint32_t typeID = 0;
+
+	inline static uint32_t numSystemTypes = 0;
 };
@@ -8,6 +8,7 @@ class DirectionalLightComponent : public SpatialComponent
 {
 public:
 	COMPONENT_SYSTEM(DirectionalLightComponent);
+	SYSTEM_ACCESS(SystemResources::Transforms, SystemResources::Lights)
 
 	DirectionalLightComponent() {}
 	void Create() override;
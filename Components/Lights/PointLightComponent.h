@@ -9,6 +9,11 @@ class PointLightComponent : public SpatialComponent
 public:
 	COMPONENT_SYSTEM(PointLightComponent);
 
+	//Only ever used as a root component (PointLightActor), so getting the world position in Tick()
+	//doesn't walk into another component's transform.
+	PARALLEL_TICK
+	SYSTEM_ACCESS(SystemResources::Transforms, SystemResources::Lights)
+
 	PointLightComponent() {}
 	void Create() override;
 	void Tick(float deltaTime) override;
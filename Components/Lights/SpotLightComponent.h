@@ -8,6 +8,7 @@ class SpotLightComponent : public SpatialComponent
 {
 public:
 	COMPONENT_SYSTEM(SpotLightComponent);
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::None)
 
 	SpotLightComponent() {}
 	void Create() override;
@@ -13,6 +13,7 @@
 #include "Render/MaterialSystem.h"
 #include "Render/Renderer.h"
 #include "Render/TextureSystem.h"
+#include "Core/PropsSchema.h"
 #include "Render/VertexShader.h"
 #include "Render/PixelShader.h"
 #include "Physics/PhysicsSystem.h"
@@ -69,12 +70,13 @@ std::vector<MeshComponent*> MeshComponent::SortMeshComponentsByDistance()
 
 	const XMVECTOR cameraPos = activeCamera->GetWorldPositionV();
 
-	for (auto& mesh : system.GetComponents())
-	{
+	meshPacks.reserve(system.GetNumComponents());
+
+	system.ForEachComponent([&](MeshComponent* mesh) {
 		float distance = XMVector3Length(cameraPos - mesh->GetWorldPositionV()).m128_f32[0];
-		MeshPack pack = { mesh.get(), distance } ;
+		MeshPack pack = { mesh, distance } ;
 		meshPacks.emplace_back(pack);
-	}
+	});
 
 	auto DistCompare = [](const MeshPack& leftPack, const MeshPack& rightPack)
 	{
@@ -83,6 +85,7 @@ std::vector<MeshComponent*> MeshComponent::SortMeshComponentsByDistance()
 	std::sort(meshPacks.begin(), meshPacks.end(), DistCompare);
 
 	std::vector<MeshComponent*> sortedMeshes;
+	sortedMeshes.reserve(meshPacks.size());
 	for (auto& pack : meshPacks)
 	{
 		sortedMeshes.emplace_back(pack.mesh);
@@ -129,12 +132,20 @@ void MeshComponent::Create()
 void MeshComponent::Destroy()
 {
 	//Erase physics actor
-	PhysicsSystem::ReleasePhysicsActor(this);
+	ReleasePhysicsActor();
 
 	material->Destroy();
 	material = nullptr;
 }
 
+//Lets packed records (binary worlds) hold the mesh by filename.
+static const bool meshComponentDataCodecRegistered = [] {
+	PropsSchema::RegisterFieldCodec<MeshComponentData>("MeshComponentData",
+		[](PackedRecords& records, const MeshComponentData& data) { records.WriteString(data.filename); },
+		[](PackedRecords& records, MeshComponentData& data) { return records.ReadString(data.filename); });
+	return true;
+}();
+
 static void ReassignMesh(void* data)
 {
 	auto meshData = (MeshComponentData*)data;
@@ -174,16 +185,78 @@ void MeshComponent::SplitMeshCreate()
 		&meshDataProxy.vertices->at(0).pos, sizeof(Vertex));
 	BoundingOrientedBox::CreateFromBoundingBox(boundingBox, bb);
 
+	CreateSplitMeshPhysicsActor();
+}
+
+void MeshComponent::CreateSplitMeshPhysicsActor()
+{
 	//@Todo: owner being set as null on CreatePhysicsActor() won't explode the program,
 	//but it will cause problems if you want to use raycasts via PhysX.
 	if (meshDataProxy.vertices->size() > 255)
 	{
-		PhysicsSystem::CreatePhysicsActor(this, PhysicsType::Dynamic, GetOwner());
+		isStatic = false;
+		CreateRigidPhysicsActor();
 	}
 	else
 	{
-		PhysicsSystem::CreateConvexPhysicsMesh(this, GetOwner());
+		CreateConvexPhysicsActor();
+	}
+}
+
+void MeshComponent::CreateRigidPhysicsActor()
+{
+	PhysicsSystem::CreatePhysicsActor(this, isStatic ? PhysicsType::Static : PhysicsType::Dynamic, GetOwner());
+	physicsActorKind = isStatic ? PhysicsActorKind::Static : PhysicsActorKind::Dynamic;
+}
+
+void MeshComponent::CreateConvexPhysicsActor()
+{
+	PhysicsSystem::CreateConvexPhysicsMesh(this, GetOwner());
+	physicsActorKind = PhysicsActorKind::Convex;
+}
+
+void MeshComponent::ReleasePhysicsActor()
+{
+	PhysicsSystem::ReleasePhysicsActor(this);
+	physicsActorKind = PhysicsActorKind::None;
+}
+
+void MeshComponent::OnWorldSuspended()
+{
+	suspendedPhysicsActorKind = physicsActorKind;
+	if (suspendedPhysicsActorKind == PhysicsActorKind::WorldDefault)
+	{
+		if (skipPhysicsCreation)
+		{
+			suspendedPhysicsActorKind = PhysicsActorKind::None;
+		}
+		else
+		{
+			suspendedPhysicsActorKind = isStatic ? PhysicsActorKind::Static : PhysicsActorKind::Dynamic;
+		}
 	}
+
+	ReleasePhysicsActor();
+}
+
+void MeshComponent::OnWorldResumed()
+{
+	switch (suspendedPhysicsActorKind)
+	{
+	case PhysicsActorKind::Static:
+	case PhysicsActorKind::Dynamic:
+		//isStatic can be edited while suspended, put back what the mesh actually had.
+		isStatic = suspendedPhysicsActorKind == PhysicsActorKind::Static;
+		CreateRigidPhysicsActor();
+		break;
+	case PhysicsActorKind::Convex:
+		CreateConvexPhysicsActor();
+		break;
+	default:
+		break;
+	}
+
+	suspendedPhysicsActorKind = PhysicsActorKind::None;
 }
 
 void MeshComponent::SetMeshFilename(std::string_view meshFilename)
@@ -13,6 +13,8 @@ class MeshComponent : public SpatialComponent
 {
 public:
 	COMPONENT_SYSTEM(MeshComponent)
+	POOLED_COMPONENT_STORAGE
+	SYSTEM_ACCESS(SystemResources::Physics, SystemResources::Transforms)
 
 	static void ResetMeshBuffers();
 
@@ -49,8 +51,17 @@ public:
 	virtual void Destroy() override;
 	virtual Properties GetProps();
 
+	//Physics actors are released while the world sits in WorldCache and recreated on resume as they were.
+	virtual void OnWorldSuspended() override;
+	virtual void OnWorldResumed() override;
+
 	void SplitMeshCreate();
 
+	//Static or Dynamic going by isStatic. Go through these rather than PhysicsSystem so the kind of
+	//physics actor the mesh has is known when its world is suspended.
+	void CreateRigidPhysicsActor();
+	void ReleasePhysicsActor();
+
 	void SetMeshFilename(std::string_view meshFilename);
 
 	//Material set functions
@@ -83,6 +94,22 @@ public:
 	bool UsesCollisonMesh() { return !collisionMeshFilename.empty(); }
 
 private:
+	void CreateSplitMeshPhysicsActor();
+	void CreateConvexPhysicsActor();
+
+	//WorldDefault is a mesh the world's physics setup was left to create for, going by isStatic and skipPhysicsCreation.
+	enum class PhysicsActorKind : uint8_t
+	{
+		WorldDefault,
+		None,
+		Static,
+		Dynamic,
+		Convex
+	};
+
+	PhysicsActorKind physicsActorKind = PhysicsActorKind::WorldDefault;
+	PhysicsActorKind suspendedPhysicsActorKind = PhysicsActorKind::None;
+
 	std::string collisionMeshFilename;
 
 	Material* material = nullptr;
@@ -13,11 +13,9 @@ void SliceableMeshComponent::SliceMesh(XMVECTOR planeCenter, XMVECTOR planeNorma
 	const Transform originalMeshTransform = transform;
 
 	//@Todo: this will fail if the plane doesn't cut this mesh. d3d11 will explode on CreateBuffer
-	auto splitMesh0 = SplitMesh::system.Add(originalMeshTransform);
-	splitMesh0->CreateSplitMesh(mesh0Verts, this);
-
-	auto splitMesh1 = SplitMesh::system.Add(originalMeshTransform);
-	splitMesh1->CreateSplitMesh(mesh1Verts, this);
+	auto splitMeshes = SplitMesh::system.AddBatch(2, { originalMeshTransform, originalMeshTransform });
+	splitMeshes[0]->CreateSplitMesh(mesh0Verts, this);
+	splitMeshes[1]->CreateSplitMesh(mesh1Verts, this);
 
 	Remove();
 }
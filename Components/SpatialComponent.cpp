@@ -1,7 +1,24 @@
 #include "vpch.h"
 #include "SpatialComponent.h"
+#include <cstring>
 #include "Core/VMath.h"
 #include "Editor/Editor.h"
+#include "Core/JobSystem.h"
+#include "Core/SystemScheduler.h"
+#include "Core/WorldDelta.h"
+#include "Core/TransformHierarchy.h"
+#include "Actors/Actor.h"
+
+SpatialComponent::~SpatialComponent()
+{
+	TransformHierarchy::Dequeue(this);
+}
+
+void SpatialComponent::SetParent(SpatialComponent* newParent)
+{
+	parent = newParent;
+	MarkWorldDirty();
+}
 
 void SpatialComponent::AddChild(SpatialComponent* component)
 {
@@ -9,6 +26,7 @@ void SpatialComponent::AddChild(SpatialComponent* component)
 	assert(component);
 	component->parent = this;
 	children.emplace_back(component);
+	component->MarkWorldDirty();
 }
 
 void SpatialComponent::RemoveChild(SpatialComponent* component)
@@ -27,28 +45,107 @@ void SpatialComponent::RemoveChild(SpatialComponent* component)
 
 XMMATRIX SpatialComponent::GetWorldMatrix()
 {
-	XMMATRIX parentWorld = XMMatrixIdentity();
+	if (JobSystem::IsInParallelFor())
+	{
+		bool built = false;
+		return BuildUncachedWorldMatrix(built);
+	}
 
+	//Parents first, a direct write further up flags this component dirty on the way down.
+	XMMATRIX parentWorld = XMMatrixIdentity();
 	if (parent)
 	{
 		parentWorld = parent->GetWorldMatrix();
 	}
 
-	UpdateTransform(parentWorld);
+	if (LocalTransformWrittenDirectly())
+	{
+		MarkWorldDirty();
+	}
+
+	if (worldDirty)
+	{
+		SetCachedWorldMatrix(transform.GetAffine() * parentWorld);
+	}
 
 	return transform.world;
 }
 
-void SpatialComponent::UpdateTransform(XMMATRIX parentWorld)
+XMMATRIX SpatialComponent::BuildUncachedWorldMatrix(bool& built)
+{
+	XMMATRIX parentWorld = XMMatrixIdentity();
+	bool parentBuilt = false;
+	if (parent)
+	{
+		parentWorld = parent->BuildUncachedWorldMatrix(parentBuilt);
+	}
+
+	//The next serial read or TransformHierarchy::Update() caches it.
+	built = parentBuilt || IsWorldMatrixStale();
+	return built ? transform.GetAffine() * parentWorld : transform.world;
+}
+
+void SpatialComponent::SetCachedWorldMatrix(XMMATRIX world)
+{
+	transform.world = world;
+
+	builtPosition = transform.position;
+	builtRotation = transform.rotation;
+	builtScale = transform.scale;
+	worldDirty = false;
+}
+
+void SpatialComponent::UpdateTransform()
+{
+	//Every transform setter ends up here.
+	SYSTEM_ACCESS_CHECK(SystemResources::Transforms, true);
+
+	MarkWorldDirty();
+}
+
+void SpatialComponent::MarkWorldDirty()
 {
-	XMMATRIX world = transform.GetAffine() * parentWorld;
+	MarkSubtreeWorldDirty();
+
+	//Does nothing if already queued. The check is left to Enqueue()'s lock, Dequeue() moves other components' indices.
+	TransformHierarchy::Enqueue(this);
+}
+
+void SpatialComponent::MarkSubtreeWorldDirty()
+{
+	//Children of a dirty component are always dirty themselves, so there's nothing further down to flag.
+	if (worldDirty)
+	{
+		return;
+	}
+
+	worldDirty = true;
 
 	for (SpatialComponent* child : children)
 	{
-		child->UpdateTransform(world);
+		child->MarkSubtreeWorldDirty();
 	}
+}
 
-	transform.world = world;
+bool SpatialComponent::LocalTransformWrittenDirectly() const
+{
+	return std::memcmp(&builtPosition, &transform.position, sizeof(XMFLOAT3)) != 0
+		|| std::memcmp(&builtRotation, &transform.rotation, sizeof(XMFLOAT4)) != 0
+		|| std::memcmp(&builtScale, &transform.scale, sizeof(XMFLOAT3)) != 0;
+}
+
+void SpatialComponent::LocalTransformChanged()
+{
+	//Transforms are saved, flag the owner for the next game save.
+	if (WorldDelta::IsTracking())
+	{
+		if (Actor* owner = GetOwner())
+		{
+			owner->MarkSaveDirty();
+		}
+	}
+
+	UpdateTransform();
 }
 
 Properties SpatialComponent::GetProps()
@@ -87,25 +184,25 @@ XMVECTOR SpatialComponent::GetLocalPositionV()
 void SpatialComponent::SetLocalPosition(float x, float y, float z)
 {
 	transform.position = XMFLOAT3(x, y, z);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetLocalPosition(XMFLOAT3 newPosition)
 {
 	transform.position = newPosition;
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetLocalPosition(XMVECTOR newPosition)
 {
 	XMStoreFloat3(&transform.position, newPosition);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetWorldPosition(XMFLOAT3 position)
 {
 	SetWorldPosition(XMLoadFloat3(&position));
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetWorldPosition(XMVECTOR position)
@@ -164,25 +261,25 @@ XMVECTOR SpatialComponent::GetWorldScaleV()
 void SpatialComponent::SetLocalScale(float uniformScale)
 {
 	transform.scale = XMFLOAT3(uniformScale, uniformScale, uniformScale);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetLocalScale(float x, float y, float z)
 {
 	transform.scale = XMFLOAT3(x, y, z);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetLocalScale(XMFLOAT3 newScale)
 {
 	transform.scale = newScale;
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetLocalScale(XMVECTOR newScale)
 {
 	XMStoreFloat3(&transform.scale, newScale);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetWorldScale(float uniformScale)
@@ -232,7 +329,7 @@ XMVECTOR SpatialComponent::GetWorldRotationV()
 void SpatialComponent::SetLocalRotation(float x, float y, float z, float w)
 {
 	transform.rotation = XMFLOAT4(x, y, z, w);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 XMFLOAT4 SpatialComponent::GetLocalRotation()
@@ -243,13 +340,13 @@ XMFLOAT4 SpatialComponent::GetLocalRotation()
 void SpatialComponent::SetLocalRotation(XMFLOAT4 newRotation)
 {
 	transform.rotation = newRotation;
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 void SpatialComponent::SetLocalRotation(XMVECTOR newRotation)
 {
 	XMStoreFloat4(&transform.rotation, newRotation);
-	UpdateTransform();
+	LocalTransformChanged();
 }
 
 XMFLOAT3 SpatialComponent::GetForwardVector()
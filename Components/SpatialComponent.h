@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 #include <DirectXCollision.h>
 #include "Component.h"
@@ -14,10 +15,26 @@ public:
 	//@Todo: there's a lot of direct refs to this via properties and whatever else. Look into making it protected completely.
 	Transform transform;
 
+	~SpatialComponent();
+
 	Properties GetProps() override;
 
+	//Cached in transform.world, only rebuilt when this or a parent's local transform has changed since.
+	//Reads from inside a JobSystem::ParallelFor() build a stale matrix without caching it, see BuildUncachedWorldMatrix().
 	XMMATRIX GetWorldMatrix();
-	void UpdateTransform(XMMATRIX parentWorld = XMMatrixIdentity());
+
+	//Setters already call this, only needed after writing to transform directly.
+	void UpdateTransform();
+
+	//For TransformHierarchy, which builds world matrices for everything that moved at once.
+	bool IsWorldMatrixStale() const { return worldDirty || LocalTransformWrittenDirectly(); }
+	void SetCachedWorldMatrix(XMMATRIX world);
+
+	//Position in TransformHierarchy's queue, so a destroyed component comes out of it without a search.
+	static constexpr uint32_t notQueued = UINT32_MAX;
+	//Only read or written under TransformHierarchy's queue lock while systems are ticking.
+	uint32_t GetUpdateQueueIndex() const { return updateQueueIndex; }
+	void SetUpdateQueueIndex(uint32_t index) { updateQueueIndex = index; }
 
 	XMFLOAT3 GetLocalPosition();
 	XMVECTOR GetLocalPositionV();
@@ -66,12 +83,12 @@ public:
 	void SetBoundsExtents(XMFLOAT3 extents) { boundingBox.Extents = extents; }
 
 	auto GetTransform() { return transform; }
-	void SetTransform(const Transform& transform_) { transform = transform_; }
+	void SetTransform(const Transform& transform_) { transform = transform_; LocalTransformChanged(); }
 
 	auto GetParent() { return parent; }
-	void SetParent(SpatialComponent* newParent) { parent = newParent; }
+	void SetParent(SpatialComponent* newParent);
 
-	auto GetChildren() { return children; }
+	const auto& GetChildren() { return children; }
 	void AddChild(SpatialComponent* component);
 	void RemoveChild(SpatialComponent* component);
 
@@ -79,6 +96,13 @@ public:
 	void SetCollisionLayer(CollisionLayers layer_) { layer = layer_; }
 
 protected:
+	//Setters call this after writing the local transform.
+	void LocalTransformChanged();
+
+	//Flags this and all children's world matrices to be rebuilt on their next read,
+	//and queues this for TransformHierarchy to rebuild them at the end of the frame.
+	void MarkWorldDirty();
+
 	void Pitch(float angle);
 	void RotateY(float angle);
 	void FPSCameraRotation();
@@ -88,4 +112,23 @@ protected:
 	std::vector<SpatialComponent*> children;
 
 	CollisionLayers layer = CollisionLayers::All;
+
+private:
+	void MarkSubtreeWorldDirty();
+	bool LocalTransformWrittenDirectly() const;
+
+	//Parallel ticks and parallel stages can read the same parent chain from several threads at once,
+	//so those reads leave the cache and the dirty flags alone. built is set if anything was out of date.
+	XMMATRIX BuildUncachedWorldMatrix(bool& built);
+
+	//The local transform transform.world was last built from. Props and the editor write to transform
+	//without going through the setters, those writes are caught against this on the next read.
+	XMFLOAT3 builtPosition = XMFLOAT3(0.f, 0.f, 0.f);
+	XMFLOAT4 builtRotation = XMFLOAT4(0.f, 0.f, 0.f, 1.f);
+	XMFLOAT3 builtScale = XMFLOAT3(1.f, 1.f, 1.f);
+
+	bool worldDirty = true;
+
+	//Only set where MarkWorldDirty() was called, not on the children it flagged.
+	uint32_t updateQueueIndex = notQueued;
 };
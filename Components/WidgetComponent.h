@@ -9,6 +9,7 @@ class WidgetComponent : public Component
 {
 public:
 	COMPONENT_SYSTEM(WidgetComponent)
+	SYSTEM_ACCESS(SystemResources::None, SystemResources::None)
 
 	WidgetComponent() {}
 	virtual void Tick(float deltaTime) override;
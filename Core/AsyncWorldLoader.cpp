@@ -0,0 +1,339 @@
+#include "vpch.h"
+#include "AsyncWorldLoader.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include "Log.h"
+#include "FileSystem.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "UIDIndex.h"
+#include "World.h"
+#include "WorldFile.h"
+#include "WorldCache.h"
+#include "Actors/IActorSystem.h"
+#include "Actors/ActorSystemCache.h"
+#include "Components/IComponentSystem.h"
+#include "Components/ComponentSystemCache.h"
+#include "Gameplay/GameInstance.h"
+#include "Gameplay/GameUtils.h"
+#include "Gameplay/WorldFunctions.h"
+
+namespace AsyncWorldLoader
+{
+	using Clock = std::chrono::steady_clock;
+
+	struct StagedWorld
+	{
+		std::string worldName;
+		std::string path;
+		MappedFile file;
+		bool isBinaryWorld = false;
+		double stageMilliseconds = 0.0;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::atomic<bool> done = false;
+	};
+
+	//Shared with the worker, so a Cancel() mid stage leaves the worker something to finish writing into.
+	std::shared_ptr<StagedWorld> stagedWorld;
+	Stats lastStats;
+
+	//Most recently wanted first.
+	std::list<std::shared_ptr<StagedWorld>> prefetchedWorlds;
+	size_t prefetchBudget = 256 * 1024 * 1024;
+	PrefetchStats prefetchStats;
+
+	std::string queuedSwapWorldName;
+
+	double GetMilliseconds(Clock::time_point start)
+	{
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	void StageWorld(StagedWorld& world)
+	{
+		const Clock::time_point start = Clock::now();
+
+		if (world.file.Open(world.path))
+		{
+			//Touch every page so SwapIn() doesn't take the page faults on the main thread.
+			constexpr size_t pageSize = 4096;
+			const char* data = world.file.GetData();
+			volatile char touched = 0;
+			for (size_t offset = 0; offset < world.file.GetSize(); offset += pageSize)
+			{
+				touched = touched + data[offset];
+			}
+
+			world.isBinaryWorld = WorldFile::Validate(world.file);
+		}
+
+		world.stageMilliseconds = GetMilliseconds(start);
+
+		{
+			std::lock_guard<std::mutex> lock(world.mutex);
+			world.done = true;
+		}
+		world.condition.notify_all();
+	}
+
+	void WaitForStaging(StagedWorld& world)
+	{
+		std::unique_lock<std::mutex> lock(world.mutex);
+		world.condition.wait(lock, [&world] { return world.done.load(); });
+	}
+
+	std::shared_ptr<StagedWorld> StartStaging(const std::string& worldName)
+	{
+		auto world = std::make_shared<StagedWorld>();
+		world->worldName = worldName;
+		//Game save deltas are applied on top once the world starts, see GameUtils::LoadGameWorldState().
+		world->path = "WorldMaps/" + worldName;
+
+		JobSystem::RunAsync([world]() { StageWorld(*world); });
+		return world;
+	}
+
+	//Full saves are text worlds FileSystem loads itself, there's nothing to stage.
+	bool HasFullGameSave(const std::string& worldName)
+	{
+		return GameInstance::useGameSaves && std::filesystem::exists(GameUtils::GetFullGameSavePath(worldName));
+	}
+
+	auto FindPrefetched(const std::string& worldName)
+	{
+		return std::find_if(prefetchedWorlds.begin(), prefetchedWorlds.end(),
+			[&worldName](const std::shared_ptr<StagedWorld>& world) { return world->worldName == worldName; });
+	}
+
+	//Worlds still staging count as empty until their size is known.
+	size_t GetStagedSize(const StagedWorld& world)
+	{
+		return world.done ? world.file.GetSize() : 0;
+	}
+
+	void EvictOverBudget()
+	{
+		size_t cachedBytes = 0;
+		for (const std::shared_ptr<StagedWorld>& world : prefetchedWorlds)
+		{
+			cachedBytes += GetStagedSize(*world);
+		}
+
+		while (cachedBytes > prefetchBudget && prefetchedWorlds.size() > 1)
+		{
+			cachedBytes -= GetStagedSize(*prefetchedWorlds.back());
+			prefetchedWorlds.pop_back();
+			prefetchStats.evictions++;
+		}
+	}
+
+	void Begin(const std::string& worldName)
+	{
+		Cancel();
+
+		//SwapIn() reattaches cached worlds instead.
+		if (WorldCache::Contains(worldName) || HasFullGameSave(worldName))
+		{
+			return;
+		}
+
+		auto prefetchedIt = FindPrefetched(worldName);
+		if (prefetchedIt != prefetchedWorlds.end())
+		{
+			stagedWorld = std::move(*prefetchedIt);
+			prefetchedWorlds.erase(prefetchedIt);
+			prefetchStats.hits++;
+			return;
+		}
+
+		stagedWorld = StartStaging(worldName);
+		prefetchStats.misses++;
+	}
+
+	bool IsStaging(const std::string& worldName)
+	{
+		return stagedWorld && stagedWorld->worldName == worldName;
+	}
+
+	bool SwapIn(const std::string& worldName)
+	{
+		//Recently left worlds are reattached as they were, nothing to load.
+		if (WorldCache::Contains(worldName))
+		{
+			Cancel();
+
+			const Clock::time_point swapStart = Clock::now();
+			WorldCache::SuspendCurrentWorld();
+			WorldCache::Resume(worldName);
+
+			lastStats = Stats();
+			lastStats.worldName = worldName;
+			lastStats.swapMilliseconds = GetMilliseconds(swapStart);
+
+			Log("AsyncWorldLoader: resumed [%s] from WorldCache, %.2f ms on the main thread.",
+				worldName.c_str(), lastStats.swapMilliseconds);
+			return true;
+		}
+
+		if (!IsStaging(worldName))
+		{
+			return false;
+		}
+
+		std::shared_ptr<StagedWorld> world = std::move(stagedWorld);
+
+		const Clock::time_point waitStart = Clock::now();
+		WaitForStaging(*world);
+
+		lastStats = Stats();
+		lastStats.worldName = worldName;
+		lastStats.fileSize = world->file.GetSize();
+		lastStats.stageMilliseconds = world->stageMilliseconds;
+		lastStats.waitMilliseconds = GetMilliseconds(waitStart);
+
+		if (!world->isBinaryWorld)
+		{
+			return false;
+		}
+
+		const Clock::time_point swapStart = Clock::now();
+
+		//The world being left is kept around in case the player walks straight back.
+		WorldCache::SuspendCurrentWorld();
+
+		World::worldFilename = worldName;
+
+		if (!WorldFile::Load(world->file, world->path))
+		{
+			Log("AsyncWorldLoader: [%s] failed to load after staging.", world->path.c_str());
+
+			//Whatever was read before the failure goes, none of it has been initialised yet.
+			for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+			{
+				actorSystem->Cleanup();
+			}
+
+			for (IComponentSystem* componentSystem : ComponentSystemCache::Get().GetAllSystems())
+			{
+				componentSystem->Cleanup();
+			}
+
+			return false;
+		}
+
+		UIDIndex::RelinkAllComponentsToOwners();
+
+		for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+		{
+			actorSystem->Init();
+		}
+
+		for (IComponentSystem* componentSystem : ComponentSystemCache::Get().GetAllSystems())
+		{
+			componentSystem->Init();
+		}
+
+		for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+		{
+			actorSystem->PostInit();
+		}
+
+		for (IComponentSystem* componentSystem : ComponentSystemCache::Get().GetAllSystems())
+		{
+			componentSystem->Start();
+		}
+
+		WorldFunctions::CallWorldStartFunction(worldName);
+
+		lastStats.swapMilliseconds = GetMilliseconds(swapStart);
+
+		Log("AsyncWorldLoader: swapped in [%s] (%zu bytes), %.2f ms on the main thread (%.2f ms waiting), staged in %.2f ms.",
+			worldName.c_str(), lastStats.fileSize, lastStats.swapMilliseconds + lastStats.waitMilliseconds,
+			lastStats.waitMilliseconds, lastStats.stageMilliseconds);
+
+		return true;
+	}
+
+	void QueueSwapIn(const std::string& worldName)
+	{
+		queuedSwapWorldName = worldName;
+	}
+
+	void RunQueuedSwap()
+	{
+		if (queuedSwapWorldName.empty())
+		{
+			return;
+		}
+
+		const std::string worldName = std::move(queuedSwapWorldName);
+		queuedSwapWorldName.clear();
+
+		if (!SwapIn(worldName))
+		{
+			FileSystem::SetDeferredWorldLoad(worldName);
+		}
+	}
+
+	void Cancel()
+	{
+		//The worker holds its own reference, it finishes into a world nothing points to anymore.
+		stagedWorld.reset();
+	}
+
+	const Stats& GetLastStats()
+	{
+		return lastStats;
+	}
+
+	void Prefetch(const std::string& worldName)
+	{
+		if (IsStaging(worldName) || WorldCache::Contains(worldName) || HasFullGameSave(worldName))
+		{
+			return;
+		}
+
+		auto prefetchedIt = FindPrefetched(worldName);
+		if (prefetchedIt != prefetchedWorlds.end())
+		{
+			prefetchedWorlds.splice(prefetchedWorlds.begin(), prefetchedWorlds, prefetchedIt);
+			EvictOverBudget();
+			return;
+		}
+
+		for (const std::shared_ptr<StagedWorld>& world : prefetchedWorlds)
+		{
+			if (!world->done)
+			{
+				return;
+			}
+		}
+
+		prefetchedWorlds.push_front(StartStaging(worldName));
+		prefetchStats.prefetches++;
+	}
+
+	void SetPrefetchBudget(size_t bytes)
+	{
+		prefetchBudget = bytes;
+		EvictOverBudget();
+	}
+
+	PrefetchStats GetPrefetchStats()
+	{
+		PrefetchStats stats = prefetchStats;
+		for (const std::shared_ptr<StagedWorld>& world : prefetchedWorlds)
+		{
+			stats.cachedBytes += GetStagedSize(*world);
+		}
+		return stats;
+	}
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//Loads the next world in the background while the screen fades out, then swaps it in at the end of the fade.
+//
+//Begin() maps the world file on a JobSystem worker, faults its pages in and validates it (see WorldFile::Validate()),
+//so the world is sat in memory by the time SwapIn() runs. SwapIn() then only has to clean up the current systems
+//and read records out of the staged mapping on the main thread.
+//Text worlds are still parsed by FileSystem at swap time, staging them only warms the file cache.
+//Worlds in WorldCache skip all of this, SwapIn() reattaches them and the world left goes into the cache.
+//
+//Worlds can also be prefetched ahead of time (e.g. EntranceTrigger when the player walks near it). Prefetched
+//worlds are kept staged, least recently wanted first out once they go over the prefetch budget, and Begin()
+//takes one straight from there instead of staging it again.
+namespace AsyncWorldLoader
+{
+	struct Stats
+	{
+		std::string worldName;
+		size_t fileSize = 0;
+
+		//On the worker
+		double stageMilliseconds = 0.0;
+
+		//On the main thread. Waiting is time SwapIn() blocked on a worker that hadn't finished staging.
+		double waitMilliseconds = 0.0;
+		double swapMilliseconds = 0.0;
+	};
+
+	struct PrefetchStats
+	{
+		//Begin() calls that found their world already prefetched, and ones that didn't.
+		uint32_t hits = 0;
+		uint32_t misses = 0;
+
+		uint32_t prefetches = 0;
+
+		//Prefetched worlds dropped for the budget before they were used.
+		uint32_t evictions = 0;
+
+		size_t cachedBytes = 0;
+	};
+
+	//Starts staging worldName (e.g. "Level.vmap") from WorldMaps/, any game save delta is applied once it starts.
+	//Worlds with a full .sav game save aren't staged, SwapIn() returns false for those to load them synchronously.
+	void Begin(const std::string& worldName);
+
+	bool IsStaging(const std::string& worldName);
+
+	//Replaces the current world with the staged one. Call from outside of system ticks.
+	//Returns false without touching the current world if worldName wasn't staged as a binary world,
+	//load it through FileSystem instead. Also returns false if the staged world fails to load, in which case
+	//the world left is still in WorldCache but every system is left empty.
+	bool SwapIn(const std::string& worldName);
+
+	//Holds the swap for RunQueuedSwap(), for callers that might be mid frame (e.g. Timer callbacks).
+	void QueueSwapIn(const std::string& worldName);
+
+	//Runs the swap from QueueSwapIn(), falling back to FileSystem's deferred world load when SwapIn() can't.
+	//SystemScheduler calls this once every system has ticked for the frame.
+	void RunQueuedSwap();
+
+	//Drops the world staged by Begin(), e.g. when the level change was cancelled. Prefetched worlds are kept.
+	void Cancel();
+
+	const Stats& GetLastStats();
+
+	//Stages worldName in the background if it isn't already. Cheap to call every frame for the same world.
+	//Only one prefetch is staged at a time so they never tie up more than one worker.
+	void Prefetch(const std::string& worldName);
+
+	//Total file size prefetched worlds can hold on to. The most recently prefetched world is always kept.
+	void SetPrefetchBudget(size_t bytes);
+
+	PrefetchStats GetPrefetchStats();
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+//Generational slot table used by ActorSystem and ComponentSystem to issue handles.
+//Systems swap-and-pop their vectors on Remove(), so raw pointers and indices go stale. A handle
+//is a (slot, generation) pair where the slot tracks the object's current system index and the
+//generation is new every time the slot is issued, so old handles resolve to nothing.
+//
+//Generations come from one counter shared by every table, so a handle only ever matches the table that issued
+//it. WorldCache swaps a system's table out and back in, and a fresh table's slots would otherwise line up with
+//handles from the one it replaced.
+class HandleTable
+{
+public:
+	//Returns the slot for a newly added object sitting at index in its system.
+	uint32_t Issue(int index)
+	{
+		uint32_t slotID = 0;
+
+		if (!freeSlots.empty())
+		{
+			slotID = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		{
+			slotID = static_cast<uint32_t>(slots.size());
+			slots.emplace_back();
+		}
+
+		slots[slotID].index = index;
+		slots[slotID].generation = nextGeneration++;
+		return slotID;
+	}
+
+	//Makes room for count more handles without the slot vector reallocating mid batch.
+	void Reserve(size_t count)
+	{
+		if (count > freeSlots.size())
+		{
+			slots.reserve(slots.size() + count - freeSlots.size());
+		}
+	}
+
+	void Release(uint32_t slotID)
+	{
+		Slot& slot = slots[slotID];
+		slot.index = -1;
+		freeSlots.emplace_back(slotID);
+	}
+
+	//Call when an object is moved within its system's vector.
+	void SetIndex(uint32_t slotID, int index)
+	{
+		slots[slotID].index = index;
+	}
+
+	uint32_t GetGeneration(uint32_t slotID)
+	{
+		return slots[slotID].generation;
+	}
+
+	//Returns the system index the handle refers to, or -1 if the handle is stale.
+	int Resolve(uint32_t slotID, uint32_t generation)
+	{
+		if (slotID >= slots.size())
+		{
+			return -1;
+		}
+
+		const Slot& slot = slots[slotID];
+		if (slot.generation != generation)
+		{
+			return -1;
+		}
+
+		return slot.index;
+	}
+
+	//Invalidates every issued handle. Slots are kept for reuse instead of cleared.
+	void ReleaseAll()
+	{
+		freeSlots.clear();
+
+		for (uint32_t slotID = 0; slotID < slots.size(); slotID++)
+		{
+			slots[slotID].index = -1;
+			freeSlots.emplace_back(slotID);
+		}
+	}
+
+private:
+	struct Slot
+	{
+		uint32_t generation = 0;
+		int index = -1;
+	};
+
+	//Starts at 1 so a default constructed handle (generation 0) never resolves.
+	//Atomic as AsyncWorldLoader fills staging systems off the main thread.
+	inline static std::atomic<uint32_t> nextGeneration = 1;
+
+	std::vector<Slot> slots;
+	std::vector<uint32_t> freeSlots;
+};
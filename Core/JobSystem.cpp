@@ -0,0 +1,262 @@
+#include "vpch.h"
+#include "JobSystem.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+namespace JobSystem
+{
+	struct Job
+	{
+		const std::function<void(uint32_t, uint32_t)>* func = nullptr;
+		std::atomic<uint32_t>* remaining = nullptr;
+		uint32_t begin = 0;
+		uint32_t end = 0;
+
+		//Set instead of func for RunAsync() jobs, owned by the job.
+		std::function<void()>* task = nullptr;
+	};
+
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	std::vector<std::thread> workers;
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+
+	std::mutex sleepMutex;
+	std::condition_variable sleepCondition;
+	std::atomic<uint32_t> numQueuedJobs = 0;
+	std::atomic<uint32_t> nextQueue = 0;
+	std::atomic<bool> running = false;
+
+	std::once_flag initFlag;
+
+	//Counted rather than set, a range can start a nested ParallelFor() and help run its ranges.
+	thread_local uint32_t parallelForDepth = 0;
+
+	//Worker threads have to be joined before their std::thread objects are destroyed at exit.
+	struct ShutdownOnExit
+	{
+		~ShutdownOnExit() { Shutdown(); }
+	} shutdownOnExit;
+
+	void RunJob(Job& job)
+	{
+		if (job.task)
+		{
+			(*job.task)();
+			delete job.task;
+			return;
+		}
+
+		parallelForDepth++;
+		(*job.func)(job.begin, job.end);
+		parallelForDepth--;
+		job.remaining->fetch_sub(1, std::memory_order_release);
+	}
+
+	bool PopOwn(uint32_t queueIndex, Job& outJob)
+	{
+		WorkerQueue& queue = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty())
+		{
+			return false;
+		}
+
+		outJob = queue.jobs.back();
+		queue.jobs.pop_back();
+		numQueuedJobs--;
+		return true;
+	}
+
+	//Steal from the front of the other queues, starting after startIndex so thieves spread out.
+	//Threads waiting on a ParallelFor() pass allowAsync as false so they don't get stuck running a RunAsync() task.
+	bool Steal(uint32_t startIndex, Job& outJob, bool allowAsync = true)
+	{
+		const uint32_t numQueues = static_cast<uint32_t>(queues.size());
+		for (uint32_t i = 1; i <= numQueues; i++)
+		{
+			WorkerQueue& queue = *queues[(startIndex + i) % numQueues];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+
+			auto jobIt = queue.jobs.begin();
+			if (!allowAsync)
+			{
+				jobIt = std::find_if(queue.jobs.begin(), queue.jobs.end(), [](const Job& job) { return job.task == nullptr; });
+			}
+
+			if (jobIt != queue.jobs.end())
+			{
+				outJob = *jobIt;
+				queue.jobs.erase(jobIt);
+				numQueuedJobs--;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void WorkerLoop(uint32_t queueIndex)
+	{
+		while (running)
+		{
+			Job job;
+			if (PopOwn(queueIndex, job) || Steal(queueIndex, job))
+			{
+				RunJob(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleepCondition.wait(lock, [] { return numQueuedJobs > 0 || !running; });
+		}
+	}
+
+	void Init(uint32_t numWorkers)
+	{
+		std::call_once(initFlag, [numWorkers]() {
+			uint32_t workerCount = numWorkers;
+			if (workerCount == 0)
+			{
+				const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+				workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+			}
+
+			running = true;
+
+			for (uint32_t i = 0; i < workerCount; i++)
+			{
+				queues.emplace_back(std::make_unique<WorkerQueue>());
+			}
+
+			for (uint32_t i = 0; i < workerCount; i++)
+			{
+				workers.emplace_back(WorkerLoop, i);
+			}
+		});
+	}
+
+	void Shutdown()
+	{
+		if (!running)
+		{
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			running = false;
+		}
+		sleepCondition.notify_all();
+
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		workers.clear();
+		queues.clear();
+	}
+
+	uint32_t GetNumWorkers()
+	{
+		return static_cast<uint32_t>(workers.size());
+	}
+
+	void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		if (count == 0)
+		{
+			return;
+		}
+
+		Init();
+
+		if (grainSize == 0)
+		{
+			grainSize = 1;
+		}
+
+		//Not worth waking anyone for a single range.
+		if (count <= grainSize || queues.empty())
+		{
+			func(0, count);
+			return;
+		}
+
+		const uint32_t numRanges = (count + grainSize - 1) / grainSize;
+		std::atomic<uint32_t> remaining = numRanges;
+
+		//Deal ranges out round-robin so every worker starts with something local to pop.
+		const uint32_t numQueues = static_cast<uint32_t>(queues.size());
+		const uint32_t firstQueue = nextQueue.fetch_add(1) % numQueues;
+		for (uint32_t rangeIndex = 0; rangeIndex < numRanges; rangeIndex++)
+		{
+			Job job;
+			job.func = &func;
+			job.remaining = &remaining;
+			job.begin = rangeIndex * grainSize;
+			job.end = std::min(job.begin + grainSize, count);
+
+			WorkerQueue& queue = *queues[(firstQueue + rangeIndex) % numQueues];
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.emplace_back(job);
+			numQueuedJobs++;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		sleepCondition.notify_all();
+
+		//The calling thread helps out instead of blocking, which also keeps nested ParallelFor()s from deadlocking.
+		while (remaining.load(std::memory_order_acquire) > 0)
+		{
+			Job job;
+			if (Steal(firstQueue, job, false))
+			{
+				RunJob(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	bool IsInParallelFor()
+	{
+		return parallelForDepth > 0;
+	}
+
+	void RunAsync(std::function<void()> task)
+	{
+		Init();
+
+		Job job;
+		job.task = new std::function<void()>(std::move(task));
+
+		const uint32_t numQueues = static_cast<uint32_t>(queues.size());
+		WorkerQueue& queue = *queues[nextQueue.fetch_add(1) % numQueues];
+		{
+			std::lock_guard<std::mutex> lock(queue.mutex);
+			queue.jobs.emplace_back(job);
+			numQueuedJobs++;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		sleepCondition.notify_all();
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+//Add inside an Actor or Component class whose Tick() only touches its own state to have its
+//system split Tick() into ranges across the JobSystem. Tick()s of flagged types can't spawn actors/components,
+//call into the Editor or UI, or read other objects' mutable state. Destroy() is fine, removes are queued.
+//Non-flagged systems keep ticking serially in their usual order.
+#define PARALLEL_TICK inline static constexpr bool parallelTickSafe = true;
+
+template <typename T>
+concept ParallelTickSafe = requires { requires T::parallelTickSafe; };
+
+//Work-stealing thread pool. Each worker owns a deque it pushes and pops from the back of,
+//and idle workers (and the thread waiting on a ParallelFor()) steal from the front of others.
+namespace JobSystem
+{
+	//Worker threads are started on first use. Pass 0 to use hardware_concurrency() - 1 workers.
+	void Init(uint32_t numWorkers = 0);
+	void Shutdown();
+
+	uint32_t GetNumWorkers();
+
+	//Splits [0, count) into ranges of at most grainSize and calls func(begin, end) for each of them
+	//across the workers and the calling thread. Returns once every range has finished.
+	void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func);
+
+	//True on a thread running one of ParallelFor()'s ranges, other ranges may be running alongside it.
+	//False for a ParallelFor() small enough to run inline and for RunAsync() tasks.
+	bool IsInParallelFor();
+
+	//Queues task to run on a worker and returns straight away, for long running work like loading.
+	//Only workers pick these up, a thread helping out in ParallelFor() never runs one inline.
+	//Completion is up to the task to signal.
+	void RunAsync(std::function<void()> task);
+}
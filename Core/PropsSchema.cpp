@@ -0,0 +1,667 @@
+#include "vpch.h"
+#include "PropsSchema.h"
+#include <algorithm>
+#include <cstring>
+
+uint32_t StringPool::Add(const void* data, size_t size)
+{
+	std::string str(static_cast<const char*>(data), size);
+
+	auto offsetIt = offsets.find(str);
+	if (offsetIt != offsets.end())
+	{
+		return offsetIt->second;
+	}
+
+	const uint32_t offset = static_cast<uint32_t>(bytes.size());
+	bytes.append(str);
+	offsets.emplace(std::move(str), offset);
+	return offset;
+}
+
+void PackedRecords::Write(const void* data, size_t size)
+{
+	bytes.append(static_cast<const char*>(data), size);
+}
+
+void PackedRecords::WriteString(const std::string& str)
+{
+	WriteStringBytes(str.data(), static_cast<uint32_t>(str.size()), sizeof(char));
+}
+
+void PackedRecords::WriteWString(const std::wstring& str)
+{
+	WriteStringBytes(str.data(), static_cast<uint32_t>(str.size()), sizeof(wchar_t));
+}
+
+void PackedRecords::WriteStringBytes(const void* data, uint32_t length, size_t charSize)
+{
+	if (writeStringPool)
+	{
+		const uint32_t offset = writeStringPool->Add(data, length * charSize);
+		Write(offset);
+		Write(length);
+		return;
+	}
+
+	Write(length);
+	Write(data, length * charSize);
+}
+
+void PackedRecords::Overwrite(size_t position, const void* data, size_t size)
+{
+	assert(position + size <= bytes.size());
+	std::memcpy(bytes.data() + position, data, size);
+}
+
+bool PackedRecords::Read(void* data, size_t size)
+{
+	if (readPosition + size > GetReadSize())
+	{
+		return false;
+	}
+
+	std::memcpy(data, GetReadData() + readPosition, size);
+	readPosition += size;
+	return true;
+}
+
+bool PackedRecords::ReadString(std::string& str)
+{
+	const char* chars = nullptr;
+	uint32_t length = 0;
+	if (!ReadStringBytes(chars, length, sizeof(char)))
+	{
+		return false;
+	}
+
+	str.assign(chars, length);
+	return true;
+}
+
+bool PackedRecords::ReadWString(std::wstring& str)
+{
+	const char* chars = nullptr;
+	uint32_t length = 0;
+	if (!ReadStringBytes(chars, length, sizeof(wchar_t)))
+	{
+		return false;
+	}
+
+	str.resize(length);
+	std::memcpy(str.data(), chars, length * sizeof(wchar_t));
+	return true;
+}
+
+bool PackedRecords::ReadStringBytes(const char*& chars, uint32_t& length, size_t charSize)
+{
+	if (stringPoolData)
+	{
+		uint32_t offset = 0;
+		if (!Read(offset) || !Read(length) || offset + length * charSize > stringPoolSize)
+		{
+			return false;
+		}
+
+		chars = stringPoolData + offset;
+		return true;
+	}
+
+	if (!Read(length) || readPosition + length * charSize > GetReadSize())
+	{
+		return false;
+	}
+
+	chars = GetReadData() + readPosition;
+	readPosition += length * charSize;
+	return true;
+}
+
+bool PackedRecords::Skip(size_t size)
+{
+	if (readPosition + size > GetReadSize())
+	{
+		return false;
+	}
+
+	readPosition += size;
+	return true;
+}
+
+//Property types records hold as plain bytes. Anything not in here keeps going through Properties.
+static uint32_t GetPodSize(std::type_index type)
+{
+	static const std::vector<std::pair<std::type_index, uint32_t>> podTypes = {
+		{ typeid(bool), sizeof(bool) },
+		{ typeid(int), sizeof(int) },
+		{ typeid(uint32_t), sizeof(uint32_t) },
+		{ typeid(int64_t), sizeof(int64_t) },
+		{ typeid(uint64_t), sizeof(uint64_t) },
+		{ typeid(float), sizeof(float) },
+		{ typeid(double), sizeof(double) },
+		{ typeid(XMFLOAT2), sizeof(XMFLOAT2) },
+		{ typeid(XMFLOAT3), sizeof(XMFLOAT3) },
+		{ typeid(XMFLOAT4), sizeof(XMFLOAT4) },
+	};
+
+	for (auto& [podType, size] : podTypes)
+	{
+		if (podType == type)
+		{
+			return size;
+		}
+	}
+
+	return 0;
+}
+
+static std::type_index GetPropertyType(const Property& prop)
+{
+	return prop.info.value();
+}
+
+std::vector<PropsSchema::FieldCodec>& PropsSchema::GetFieldCodecs()
+{
+	static std::vector<FieldCodec> fieldCodecs;
+	return fieldCodecs;
+}
+
+void PropsSchema::AddFieldCodec(const char* name, std::type_index type,
+	std::function<void(PackedRecords&, const void*)> write, std::function<bool(PackedRecords&, void*)> read)
+{
+	GetFieldCodecs().emplace_back(FieldCodec{ name, type, std::move(write), std::move(read) });
+}
+
+//Works out a property's kind and size from its type, returns false for types records can't hold.
+bool PropsSchema::GetFieldType(const Property& prop, FieldKind& kind, uint32_t& size, uint32_t& codecIndex)
+{
+	const std::type_index type = GetPropertyType(prop);
+	size = 0;
+	codecIndex = UINT32_MAX;
+
+	if (type == typeid(std::string))
+	{
+		kind = FieldKind::String;
+		return true;
+	}
+	else if (type == typeid(std::wstring))
+	{
+		kind = FieldKind::WString;
+		return true;
+	}
+
+	size = GetPodSize(type);
+	if (size > 0)
+	{
+		kind = FieldKind::Pod;
+		return true;
+	}
+
+	const auto& fieldCodecs = GetFieldCodecs();
+	for (uint32_t i = 0; i < fieldCodecs.size(); i++)
+	{
+		if (fieldCodecs[i].type == type)
+		{
+			kind = FieldKind::Custom;
+			codecIndex = i;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool PropsSchema::Build(Properties& props, const Base* bases, size_t basesCount)
+{
+	built = true;
+	valid = false;
+	recordable = false;
+	fields.clear();
+	unrecordableFields.clear();
+	podRuns.clear();
+
+	//Offsets are only usable if every field can be reached from bases and nothing needs a change callback.
+	bool offsetsValid = true;
+
+	for (auto& [propName, prop] : props.propMap)
+	{
+		Field field;
+		field.name = propName;
+		if (!GetFieldType(prop, field.kind, field.size, field.codecIndex))
+		{
+			unrecordableFields.emplace_back(propName);
+			continue;
+		}
+
+		//Change callbacks (e.g. reloading a mesh) have to run through Properties.
+		if (prop.change)
+		{
+			offsetsValid = false;
+		}
+
+		//Only the start of custom fields is checked, their codecs don't know the type's size.
+		size_t fieldSize = field.size;
+		if (field.kind == FieldKind::String)
+		{
+			fieldSize = sizeof(std::string);
+		}
+		else if (field.kind == FieldKind::WString)
+		{
+			fieldSize = sizeof(std::wstring);
+		}
+		else if (field.kind == FieldKind::Custom)
+		{
+			fieldSize = 1;
+		}
+
+		const char* data = static_cast<const char*>(prop.data);
+
+		bool foundBase = false;
+		for (uint32_t baseIndex = 0; baseIndex < basesCount; baseIndex++)
+		{
+			const char* baseAddress = static_cast<const char*>(bases[baseIndex].address);
+			if (data >= baseAddress && data + fieldSize <= baseAddress + bases[baseIndex].size)
+			{
+				field.baseIndex = baseIndex;
+				field.offset = static_cast<uint32_t>(data - baseAddress);
+				foundBase = true;
+				break;
+			}
+		}
+
+		if (!foundBase)
+		{
+			offsetsValid = false;
+		}
+
+		fields.emplace_back(field);
+	}
+
+	if (!unrecordableFields.empty())
+	{
+		fields.clear();
+		return false;
+	}
+
+	recordable = true;
+
+	std::stable_sort(fields.begin(), fields.end(), [](const Field& a, const Field& b) {
+		const bool aIsPod = a.kind == FieldKind::Pod;
+		const bool bIsPod = b.kind == FieldKind::Pod;
+		if (aIsPod != bIsPod)
+		{
+			return aIsPod;
+		}
+		if (!aIsPod)
+		{
+			return false;
+		}
+		return a.baseIndex != b.baseIndex ? a.baseIndex < b.baseIndex : a.offset < b.offset;
+	});
+
+	firstVariableField = 0;
+	for (const Field& field : fields)
+	{
+		if (field.kind != FieldKind::Pod)
+		{
+			break;
+		}
+
+		firstVariableField++;
+
+		if (!offsetsValid)
+		{
+			continue;
+		}
+
+		if (!podRuns.empty())
+		{
+			PodRun& lastRun = podRuns.back();
+			const uint32_t lastRunEnd = lastRun.offset + lastRun.size;
+
+			if (lastRun.baseIndex == field.baseIndex)
+			{
+				//Same memory under two names would be written twice and read back out of order.
+				if (field.offset < lastRunEnd)
+				{
+					offsetsValid = false;
+					continue;
+				}
+
+				if (field.offset == lastRunEnd)
+				{
+					lastRun.size += field.size;
+					continue;
+				}
+			}
+		}
+
+		podRuns.emplace_back(PodRun{ field.baseIndex, field.offset, field.size });
+	}
+
+	if (!offsetsValid)
+	{
+		podRuns.clear();
+	}
+
+	valid = offsetsValid;
+	return valid;
+}
+
+void PropsSchema::WriteHeader(PackedRecords& records) const
+{
+	records.Write(static_cast<uint32_t>(fields.size()));
+
+	for (const Field& field : fields)
+	{
+		records.WriteString(field.name);
+		records.Write(field.kind);
+		records.Write(field.size);
+
+		if (field.kind == FieldKind::Custom)
+		{
+			records.WriteString(GetFieldCodecs()[field.codecIndex].name);
+		}
+	}
+}
+
+PropsSchema::FileLayout PropsSchema::ReadHeader(PackedRecords& records) const
+{
+	FileLayout layout;
+
+	uint32_t numFields = 0;
+	records.Read(numFields);
+
+	layout.fields.resize(numFields);
+	layout.fieldMapping.resize(numFields, -1);
+	layout.matchesSchema = valid && numFields == fields.size();
+
+	const auto& fieldCodecs = GetFieldCodecs();
+
+	for (uint32_t fileFieldIndex = 0; fileFieldIndex < numFields; fileFieldIndex++)
+	{
+		Field& fileField = layout.fields[fileFieldIndex];
+		records.ReadString(fileField.name);
+		records.Read(fileField.kind);
+		records.Read(fileField.size);
+
+		if (fileField.kind == FieldKind::Custom)
+		{
+			std::string codecName;
+			records.ReadString(codecName);
+
+			for (uint32_t codecIndex = 0; codecIndex < fieldCodecs.size(); codecIndex++)
+			{
+				if (fieldCodecs[codecIndex].name == codecName)
+				{
+					fileField.codecIndex = codecIndex;
+					break;
+				}
+			}
+		}
+
+		for (size_t fieldIndex = 0; fieldIndex < fields.size(); fieldIndex++)
+		{
+			const Field& field = fields[fieldIndex];
+			if (field.name == fileField.name && field.kind == fileField.kind
+				&& field.size == fileField.size && field.codecIndex == fileField.codecIndex)
+			{
+				layout.fieldMapping[fileFieldIndex] = static_cast<int>(fieldIndex);
+				break;
+			}
+		}
+
+		if (layout.fieldMapping[fileFieldIndex] != static_cast<int>(fileFieldIndex))
+		{
+			layout.matchesSchema = false;
+		}
+	}
+
+	return layout;
+}
+
+void PropsSchema::WriteRecord(PackedRecords& records, void* const* baseAddresses) const
+{
+	for (const PodRun& run : podRuns)
+	{
+		records.Write(static_cast<const char*>(baseAddresses[run.baseIndex]) + run.offset, run.size);
+	}
+
+	for (size_t fieldIndex = firstVariableField; fieldIndex < fields.size(); fieldIndex++)
+	{
+		const Field& field = fields[fieldIndex];
+		WriteField(records, field, static_cast<const char*>(baseAddresses[field.baseIndex]) + field.offset);
+	}
+}
+
+void PropsSchema::ReadRecord(PackedRecords& records, void* const* baseAddresses, const FileLayout& layout) const
+{
+	if (layout.matchesSchema)
+	{
+		for (const PodRun& run : podRuns)
+		{
+			records.Read(static_cast<char*>(baseAddresses[run.baseIndex]) + run.offset, run.size);
+		}
+
+		for (size_t fieldIndex = firstVariableField; fieldIndex < fields.size(); fieldIndex++)
+		{
+			const Field& field = fields[fieldIndex];
+			ReadField(records, field, static_cast<char*>(baseAddresses[field.baseIndex]) + field.offset);
+		}
+
+		return;
+	}
+
+	//Fields were added, removed or changed type since the file was written.
+	for (size_t fileFieldIndex = 0; fileFieldIndex < layout.fields.size(); fileFieldIndex++)
+	{
+		const Field& fileField = layout.fields[fileFieldIndex];
+		const int fieldIndex = layout.fieldMapping[fileFieldIndex];
+
+		if (fieldIndex < 0)
+		{
+			SkipField(records, fileField);
+			continue;
+		}
+
+		const Field& field = fields[fieldIndex];
+		ReadField(records, fileField, static_cast<char*>(baseAddresses[field.baseIndex]) + field.offset);
+	}
+}
+
+void PropsSchema::WriteRecordFromProps(PackedRecords& records, Properties& props) const
+{
+	for (const Field& field : fields)
+	{
+		auto propIt = props.propMap.find(field.name);
+		if (propIt != props.propMap.end())
+		{
+			WriteField(records, field, propIt->second.data);
+			continue;
+		}
+
+		//This object's props are missing a field the first object had, write an empty value.
+		switch (field.kind)
+		{
+		case FieldKind::Pod:
+		{
+			const std::string zeroes(field.size, '\0');
+			records.Write(zeroes.data(), zeroes.size());
+			break;
+		}
+		case FieldKind::String:
+			records.WriteString(std::string());
+			break;
+		case FieldKind::WString:
+			records.WriteWString(std::wstring());
+			break;
+		case FieldKind::Custom:
+			records.Write(static_cast<uint32_t>(0));
+			break;
+		}
+	}
+}
+
+void PropsSchema::ReadRecordIntoProps(PackedRecords& records, const FileLayout& layout, Properties& props)
+{
+	for (const Field& fileField : layout.fields)
+	{
+		auto propIt = props.propMap.find(fileField.name);
+		if (propIt != props.propMap.end())
+		{
+			FieldKind kind;
+			uint32_t size = 0;
+			uint32_t codecIndex = UINT32_MAX;
+			if (GetFieldType(propIt->second, kind, size, codecIndex) && kind == fileField.kind
+				&& size == fileField.size && codecIndex == fileField.codecIndex)
+			{
+				ReadField(records, fileField, propIt->second.data);
+				continue;
+			}
+		}
+
+		SkipField(records, fileField);
+	}
+}
+
+bool PropsSchema::SkipRecords(PackedRecords& records, uint32_t numRecords)
+{
+	uint32_t numFields = 0;
+	if (!records.Read(numFields))
+	{
+		return false;
+	}
+
+	//Grown as fields are read so a bad count runs out of bytes instead of allocating for it.
+	std::vector<Field> fileFields;
+	for (uint32_t fileFieldIndex = 0; fileFieldIndex < numFields; fileFieldIndex++)
+	{
+		Field& fileField = fileFields.emplace_back();
+		if (!records.ReadString(fileField.name) || !records.Read(fileField.kind) || !records.Read(fileField.size))
+		{
+			return false;
+		}
+
+		std::string codecName;
+		if (fileField.kind == FieldKind::Custom && !records.ReadString(codecName))
+		{
+			return false;
+		}
+	}
+
+	if (fileFields.empty())
+	{
+		return true;
+	}
+
+	for (uint32_t recordIndex = 0; recordIndex < numRecords; recordIndex++)
+	{
+		for (const Field& fileField : fileFields)
+		{
+			if (!SkipField(records, fileField))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void PropsSchema::WriteField(PackedRecords& records, const Field& field, const void* data)
+{
+	switch (field.kind)
+	{
+	case FieldKind::Pod:
+		records.Write(data, field.size);
+		break;
+
+	case FieldKind::String:
+		records.WriteString(*static_cast<const std::string*>(data));
+		break;
+
+	case FieldKind::WString:
+		records.WriteWString(*static_cast<const std::wstring*>(data));
+		break;
+
+	case FieldKind::Custom:
+	{
+		//Size prefixed so readers without the codec can skip it.
+		const size_t sizePosition = records.GetWriteSize();
+		records.Write(static_cast<uint32_t>(0));
+
+		GetFieldCodecs()[field.codecIndex].write(records, data);
+
+		const uint32_t customSize = static_cast<uint32_t>(records.GetWriteSize() - sizePosition - sizeof(uint32_t));
+		records.Overwrite(sizePosition, &customSize, sizeof(customSize));
+		break;
+	}
+	}
+}
+
+bool PropsSchema::ReadField(PackedRecords& records, const Field& field, void* data)
+{
+	switch (field.kind)
+	{
+	case FieldKind::Pod:
+		return records.Read(data, field.size);
+
+	case FieldKind::String:
+		return records.ReadString(*static_cast<std::string*>(data));
+
+	case FieldKind::WString:
+		return records.ReadWString(*static_cast<std::wstring*>(data));
+
+	case FieldKind::Custom:
+	{
+		uint32_t customSize = 0;
+		if (!records.Read(customSize))
+		{
+			return false;
+		}
+
+		if (customSize == 0)
+		{
+			return true;
+		}
+
+		if (field.codecIndex == UINT32_MAX)
+		{
+			return records.Skip(customSize);
+		}
+
+		return GetFieldCodecs()[field.codecIndex].read(records, data);
+	}
+	}
+
+	return false;
+}
+
+bool PropsSchema::SkipField(PackedRecords& records, const Field& field)
+{
+	switch (field.kind)
+	{
+	case FieldKind::Pod:
+		return records.Skip(field.size);
+
+	case FieldKind::String:
+	{
+		std::string skipped;
+		return records.ReadString(skipped);
+	}
+
+	case FieldKind::WString:
+	{
+		std::wstring skipped;
+		return records.ReadWString(skipped);
+	}
+
+	case FieldKind::Custom:
+	{
+		uint32_t customSize = 0;
+		return records.Read(customSize) && records.Skip(customSize);
+	}
+	}
+
+	return false;
+}
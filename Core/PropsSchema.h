@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <typeindex>
+#include <unordered_map>
+#include "Properties.h"
+
+//Deduplicated strings packed records can point into instead of holding the characters inline.
+class StringPool
+{
+public:
+	//Returns the string's byte offset in the pool.
+	uint32_t Add(const void* data, size_t size);
+
+	const std::string& GetBytes() const { return bytes; }
+
+private:
+	std::string bytes;
+	std::unordered_map<std::string, uint32_t> offsets;
+};
+
+//Byte buffer packed records are built in and read back from.
+//Reads either come from the buffer itself or from a view over memory owned elsewhere (e.g. a mapped file).
+class PackedRecords
+{
+public:
+	PackedRecords() {}
+	PackedRecords(std::string data) : bytes(std::move(data)) {}
+
+	//Reads straight out of data, which has to outlive the records.
+	PackedRecords(const char* data, size_t size) : viewData(data), viewSize(size) {}
+
+	PackedRecords(const PackedRecords&) = delete;
+	PackedRecords& operator=(const PackedRecords&) = delete;
+
+	//With a pool set, strings are written as a fixed size offset and length into it, keeping records fixed size.
+	void SetStringPool(StringPool* pool) { writeStringPool = pool; }
+	void SetStringPoolView(const char* data, size_t size) { stringPoolData = data; stringPoolSize = size; }
+
+	void Write(const void* data, size_t size);
+	void WriteString(const std::string& str);
+	void WriteWString(const std::wstring& str);
+
+	//For sizes only known after the fact, see PropsSchema's custom fields.
+	void Overwrite(size_t position, const void* data, size_t size);
+
+	//Returns false if the buffer ran out, the destination is left untouched.
+	bool Read(void* data, size_t size);
+	bool ReadString(std::string& str);
+	bool ReadWString(std::wstring& str);
+	bool Skip(size_t size);
+
+	template <typename T>
+	void Write(const T& value) { Write(&value, sizeof(T)); }
+
+	template <typename T>
+	bool Read(T& value) { return Read(&value, sizeof(T)); }
+
+	void Reserve(size_t size) { bytes.reserve(size); }
+	const std::string& GetBytes() const { return bytes; }
+	size_t GetWriteSize() const { return bytes.size(); }
+
+private:
+	const char* GetReadData() const { return viewData ? viewData : bytes.data(); }
+	size_t GetReadSize() const { return viewData ? viewSize : bytes.size(); }
+
+	void WriteStringBytes(const void* data, uint32_t length, size_t charSize);
+
+	//Points chars at the string's characters, in the pool if one is set or inline.
+	bool ReadStringBytes(const char*& chars, uint32_t& length, size_t charSize);
+
+	std::string bytes;
+	size_t readPosition = 0;
+
+	const char* viewData = nullptr;
+	size_t viewSize = 0;
+
+	StringPool* writeStringPool = nullptr;
+	const char* stringPoolData = nullptr;
+	size_t stringPoolSize = 0;
+};
+
+//Where a type's serialised properties live relative to the objects GetProps() was called on.
+//Built once per system from the first object's Properties, binary save/load then packs and unpacks
+//records straight from those offsets instead of building Properties for every object.
+class PropsSchema
+{
+public:
+	//A block of memory properties can point into, e.g. the actor and its root component.
+	struct Base
+	{
+		const void* address = nullptr;
+		size_t size = 0;
+	};
+
+	enum class FieldKind : uint8_t
+	{
+		Pod,
+		String,
+		WString,
+		Custom, //Written by a codec from RegisterFieldCodec(), size prefixed
+	};
+
+	struct Field
+	{
+		std::string name;
+		uint32_t baseIndex = 0;
+		uint32_t offset = 0;
+		uint32_t size = 0;
+		uint32_t codecIndex = UINT32_MAX;
+		FieldKind kind = FieldKind::Pod;
+	};
+
+	//How the fields in a file's header map onto this schema, see ReadHeader().
+	struct FileLayout
+	{
+		std::vector<Field> fields;
+
+		//Index into the schema's fields for each file field, -1 for fields the type no longer has.
+		std::vector<int> fieldMapping;
+
+		//The file was written with this exact schema, records can be read with the bulk copies.
+		bool matchesSchema = false;
+	};
+
+	//Lets records hold a property type that isn't POD or a string. name identifies the codec in file headers.
+	template <typename T>
+	static void RegisterFieldCodec(const char* name, void(*write)(PackedRecords&, const T&), bool(*read)(PackedRecords&, T&))
+	{
+		AddFieldCodec(name, typeid(T),
+			[write](PackedRecords& records, const void* data) { write(records, *static_cast<const T*>(data)); },
+			[read](PackedRecords& records, void* data) { return read(records, *static_cast<T*>(data)); });
+	}
+
+	//Fails (leaving the schema invalid) if a property points outside of bases, has a change callback
+	//or is a type records can't hold. Those types keep serialising through Properties.
+	bool Build(Properties& props, const Base* bases, size_t basesCount);
+
+	bool IsBuilt() const { return built; }
+	bool IsValid() const { return valid; }
+
+	//Every property is a type records can hold, even if IsValid() is false.
+	//Records can then still be written from each object's Properties, see WriteRecordFromProps().
+	bool IsRecordable() const { return recordable; }
+
+	//Names of the properties whose types records can't hold, for reporting.
+	const std::vector<std::string>& GetUnrecordableFields() const { return unrecordableFields; }
+
+	void WriteHeader(PackedRecords& records) const;
+	FileLayout ReadHeader(PackedRecords& records) const;
+
+	void WriteRecord(PackedRecords& records, void* const* baseAddresses) const;
+	void ReadRecord(PackedRecords& records, void* const* baseAddresses, const FileLayout& layout) const;
+
+	//Same record as WriteRecord(), taking each field from the object's props by name.
+	void WriteRecordFromProps(PackedRecords& records, Properties& props) const;
+
+	//For when this type's schema is invalid or the file was written from props.
+	//Matches file fields to props by name.
+	static void ReadRecordIntoProps(PackedRecords& records, const FileLayout& layout, Properties& props);
+
+	//Skips a WriteHeader() header and numRecords records after it without needing the type's schema, e.g. to check
+	//a file holds everything it says it does before reading any of it. Returns false if the records run out.
+	static bool SkipRecords(PackedRecords& records, uint32_t numRecords);
+
+private:
+	struct PodRun
+	{
+		uint32_t baseIndex = 0;
+		uint32_t offset = 0;
+		uint32_t size = 0;
+	};
+
+	struct FieldCodec
+	{
+		std::string name;
+		std::type_index type;
+		std::function<void(PackedRecords&, const void*)> write;
+		std::function<bool(PackedRecords&, void*)> read;
+	};
+
+	static void AddFieldCodec(const char* name, std::type_index type,
+		std::function<void(PackedRecords&, const void*)> write, std::function<bool(PackedRecords&, void*)> read);
+	static std::vector<FieldCodec>& GetFieldCodecs();
+	static bool GetFieldType(const Property& prop, FieldKind& kind, uint32_t& size, uint32_t& codecIndex);
+
+	static void WriteField(PackedRecords& records, const Field& field, const void* data);
+	static bool ReadField(PackedRecords& records, const Field& field, void* data);
+	static bool SkipField(PackedRecords& records, const Field& field);
+
+	std::vector<Field> fields;
+	std::vector<std::string> unrecordableFields;
+
+	//Fields are kept in record order: POD fields by base and offset, then strings and custom fields.
+	//The POD fields are written as runs, contiguous fields merged into one copy.
+	std::vector<PodRun> podRuns;
+	uint32_t firstVariableField = 0;
+
+	bool built = false;
+	bool valid = false;
+	bool recordable = false;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <tuple>
+#include <string_view>
+#include <typeinfo>
+#include "Properties.h"
+
+//Compile-time property tables. A type lists the fields it exposes once with REFLECT_FIELDS() as a constexpr
+//table of names and member pointers, and GetProps() becomes an adapter filling Properties from the table.
+//Lookups by name walk the table directly, nothing is built at runtime.
+
+using PropertyChangeFunc = void(*)(void*);
+
+template <typename Class, typename Field>
+struct FieldDescriptor
+{
+	using FieldType = Field;
+
+	const char* name = nullptr;
+	Field Class::* member = nullptr;
+	bool hide = false;
+	PropertyChangeFunc change = nullptr;
+
+	Field* GetData(Class* object) const { return &(object->*member); }
+};
+
+//For globals and statics, e.g. GameInstance's save data.
+template <typename Field>
+struct GlobalFieldDescriptor
+{
+	using FieldType = Field;
+
+	const char* name = nullptr;
+	Field* data = nullptr;
+	bool hide = false;
+	PropertyChangeFunc change = nullptr;
+
+	Field* GetData(void*) const { return data; }
+};
+
+template <typename Class, typename Field>
+constexpr auto ReflectField(const char* name, Field Class::* member, bool hide = false, PropertyChangeFunc change = nullptr)
+{
+	return FieldDescriptor<Class, Field>{ name, member, hide, change };
+}
+
+template <typename Field>
+constexpr auto ReflectGlobal(const char* name, Field* data, bool hide = false, PropertyChangeFunc change = nullptr)
+{
+	return GlobalFieldDescriptor<Field>{ name, data, hide, change };
+}
+
+//Specialised for each reflected type through REFLECT_FIELDS().
+template <typename T>
+struct ReflectedFields;
+
+template <typename T>
+concept Reflected = requires { ReflectedFields<T>::fields; };
+
+//Goes after the type's definition (member pointers need the complete type), at namespace scope.
+//Only lists the type's own fields, GetProps() still calls its parent's for the rest.
+#define REFLECT_FIELDS(type, ...) \
+template <> struct ReflectedFields<type> { static constexpr auto fields = std::make_tuple(__VA_ARGS__); };
+
+namespace Reflection
+{
+	template <Reflected T>
+	constexpr size_t GetNumFields()
+	{
+		return std::tuple_size_v<decltype(ReflectedFields<T>::fields)>;
+	}
+
+	//Calls visitor(descriptor) for each of T's fields in table order.
+	template <Reflected T, typename Visitor>
+	constexpr void ForEachField(Visitor&& visitor)
+	{
+		std::apply([&](const auto&... fields) { (visitor(fields), ...); }, ReflectedFields<T>::fields);
+	}
+
+	//Adds T's fields to props the same way a chain of props.Add() calls would.
+	//object can be null for tables of ReflectGlobal() fields.
+	template <Reflected T>
+	void AddFields(Properties& props, T* object)
+	{
+		ForEachField<T>([&](const auto& field) {
+			Property& prop = props.Add(field.name, field.GetData(object));
+			prop.hide = field.hide;
+			if (field.change)
+			{
+				prop.change = field.change;
+			}
+		});
+	}
+
+	//Returns the named field's data if it exists and is of the given type, else nullptr.
+	template <Reflected T>
+	void* FindFieldData(T* object, std::string_view name, const std::type_info& type)
+	{
+		void* found = nullptr;
+		ForEachField<T>([&](const auto& field) {
+			using FieldType = typename std::decay_t<decltype(field)>::FieldType;
+			if (found == nullptr && typeid(FieldType) == type && name == field.name)
+			{
+				found = field.GetData(object);
+			}
+		});
+		return found;
+	}
+
+	template <typename Field, Reflected T>
+	Field* FindField(T* object, std::string_view name)
+	{
+		return static_cast<Field*>(FindFieldData(object, name, typeid(Field)));
+	}
+};
@@ -0,0 +1,70 @@
+#include "vpch.h"
+#include "Symbol.h"
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+	struct SymbolTable
+	{
+		//deque so strings never move, the map's views point into them.
+		std::deque<std::string> strings;
+		std::unordered_map<std::string_view, uint32_t> ids;
+		std::mutex mutex;
+
+		SymbolTable()
+		{
+			strings.emplace_back();
+			ids.emplace(strings.back(), 0);
+		}
+	};
+
+	//Function static so Symbols can be made during static init (e.g. GameplayTags).
+	SymbolTable& GetSymbolTable()
+	{
+		static SymbolTable table;
+		return table;
+	}
+}
+
+uint32_t Symbol::Intern(std::string_view str)
+{
+	SymbolTable& table = GetSymbolTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+
+	auto idIt = table.ids.find(str);
+	if (idIt != table.ids.end())
+	{
+		return idIt->second;
+	}
+
+	const uint32_t newID = static_cast<uint32_t>(table.strings.size());
+	table.strings.emplace_back(str);
+	table.ids.emplace(table.strings.back(), newID);
+
+	return newID;
+}
+
+Symbol Symbol::Find(std::string_view str)
+{
+	SymbolTable& table = GetSymbolTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+
+	Symbol symbol;
+
+	auto idIt = table.ids.find(str);
+	if (idIt != table.ids.end())
+	{
+		symbol.id = idIt->second;
+	}
+
+	return symbol;
+}
+
+const std::string& Symbol::GetString() const
+{
+	SymbolTable& table = GetSymbolTable();
+	std::lock_guard<std::mutex> lock(table.mutex);
+	return table.strings[id];
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+
+//Interned string. Equal strings share one 32-bit ID from a global table, so compares and hashes
+//are integer ops and holding a Symbol costs no heap allocation. ID 0 is the empty/invalid symbol.
+class Symbol
+{
+public:
+	Symbol() {}
+	explicit Symbol(std::string_view str) : id(Intern(str)) {}
+
+	//Returns the symbol for str if it has already been interned, without adding it to the table.
+	//Lookups like HasTag() use this so unknown strings don't grow the table.
+	static Symbol Find(std::string_view str);
+
+	const std::string& GetString() const;
+	uint32_t GetID() const { return id; }
+	bool IsValid() const { return id != 0; }
+
+	bool operator==(const Symbol& other) const { return id == other.id; }
+	bool operator!=(const Symbol& other) const { return id != other.id; }
+
+	//Orders by ID (interning order), not alphabetically.
+	bool operator<(const Symbol& other) const { return id < other.id; }
+
+private:
+	static uint32_t Intern(std::string_view str);
+
+	uint32_t id = 0;
+};
+
+template <>
+struct std::hash<Symbol>
+{
+	size_t operator()(const Symbol& symbol) const { return std::hash<uint32_t>()(symbol.GetID()); }
+};
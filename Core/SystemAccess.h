@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+
+//Shared engine state a system's Tick() reads or writes. SystemScheduler ticks systems whose
+//accesses don't conflict at the same time.
+namespace SystemResources
+{
+	constexpr uint32_t None = 0;
+	constexpr uint32_t Transforms = 1 << 0;
+	constexpr uint32_t Grid = 1 << 1;
+	constexpr uint32_t UI = 1 << 2;
+	constexpr uint32_t Audio = 1 << 3;
+	constexpr uint32_t Lights = 1 << 4;
+	constexpr uint32_t Physics = 1 << 5;
+	constexpr uint32_t Gameplay = 1 << 6; //BattleSystem, GameInstance, input and camera state
+	constexpr uint32_t WorldLayout = 1 << 7; //Spawning and destroying actors and components
+	constexpr uint32_t All = 0xFFFFFFFF;
+
+	constexpr uint32_t numResources = 8;
+
+	inline const char* GetName(uint32_t resourceIndex)
+	{
+		constexpr const char* names[numResources] = {
+			"Transforms", "Grid", "UI", "Audio", "Lights", "Physics", "Gameplay", "WorldLayout" };
+		return resourceIndex < numResources ? names[resourceIndex] : "Unknown";
+	}
+};
+
+//Systems that don't declare their access read and write everything, so they tick on their own.
+struct SystemAccess
+{
+	uint32_t reads = SystemResources::All;
+	uint32_t writes = SystemResources::All;
+
+	bool ConflictsWith(const SystemAccess& other) const
+	{
+		return (writes & (other.reads | other.writes)) != 0 || (other.writes & reads) != 0;
+	}
+};
+
+//Add inside an Actor or Component class to declare what its system's Tick() touches, e.g.
+//SYSTEM_ACCESS(SystemResources::Transforms, SystemResources::Lights)
+//Derived classes inherit the declaration, redeclare it if they override Tick().
+#define SYSTEM_ACCESS(readResources, writeResources) inline static constexpr SystemAccess systemAccess = { readResources, writeResources };
+
+template <typename T>
+concept DeclaresSystemAccess = requires { T::systemAccess; };
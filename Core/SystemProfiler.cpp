@@ -0,0 +1,152 @@
+#include "vpch.h"
+#include "SystemProfiler.h"
+
+#if SYSTEM_PROFILER_ENABLED
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <map>
+#include <algorithm>
+
+namespace SystemProfiler
+{
+	std::mutex framesMutex;
+	std::array<std::vector<ProfileSample>, numFramesKept> frames;
+	uint64_t frameCount = 0;
+
+	std::atomic<uint32_t> nextThreadIndex = 0;
+	thread_local uint32_t threadIndex = nextThreadIndex++;
+
+	const auto startTime = std::chrono::steady_clock::now();
+
+	std::vector<ProfileSample>& GetFrame(uint64_t frame)
+	{
+		return frames[frame % numFramesKept];
+	}
+
+	const char* GetEventName(ProfileEvent event)
+	{
+		switch (event)
+		{
+		case ProfileEvent::Tick: return "Tick";
+		case ProfileEvent::Init: return "Init";
+		case ProfileEvent::Start: return "Start";
+		case ProfileEvent::Serialise: return "Serialise";
+		case ProfileEvent::Deserialise: return "Deserialise";
+		case ProfileEvent::Remove: return "Remove";
+		}
+
+		return "Unknown";
+	}
+
+	void BeginFrame()
+	{
+		std::lock_guard<std::mutex> lock(framesMutex);
+		frameCount++;
+		GetFrame(frameCount).clear();
+	}
+
+	void Record(const ProfileSample& sample)
+	{
+		ProfileSample threadSample = sample;
+		threadSample.threadIndex = threadIndex;
+
+		std::lock_guard<std::mutex> lock(framesMutex);
+		GetFrame(frameCount).emplace_back(threadSample);
+	}
+
+	std::vector<SystemStats> GetLastFrameStats()
+	{
+		std::vector<SystemStats> stats;
+
+		std::lock_guard<std::mutex> lock(framesMutex);
+		if (frameCount == 0)
+		{
+			return stats;
+		}
+
+		//Names are per system so the pointer is enough to tell them apart.
+		std::map<std::pair<const char*, ProfileEvent>, size_t> statIndices;
+
+		for (const ProfileSample& sample : GetFrame(frameCount - 1))
+		{
+			auto [statIt, added] = statIndices.try_emplace({ sample.systemName, sample.event }, stats.size());
+			if (added)
+			{
+				SystemStats& newStats = stats.emplace_back();
+				newStats.systemName = sample.systemName;
+				newStats.event = sample.event;
+			}
+
+			SystemStats& systemStats = stats[statIt->second];
+			systemStats.calls++;
+			systemStats.entityCount += sample.entityCount;
+			systemStats.totalMicroseconds += sample.durationMicroseconds;
+		}
+
+		std::sort(stats.begin(), stats.end(), [](const SystemStats& a, const SystemStats& b) {
+			return a.totalMicroseconds > b.totalMicroseconds;
+		});
+
+		return stats;
+	}
+
+	bool ExportChromeTrace(const std::string& filename)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(framesMutex);
+
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool firstEvent = true;
+		const uint64_t oldestFrame = frameCount >= numFramesKept ? frameCount - numFramesKept + 1 : 0;
+
+		for (uint64_t frame = oldestFrame; frame <= frameCount; frame++)
+		{
+			for (const ProfileSample& sample : GetFrame(frame))
+			{
+				if (!firstEvent)
+				{
+					file << ",";
+				}
+				firstEvent = false;
+
+				//System names come from typeid() so they don't need escaping.
+				file << "\n{\"name\":\"" << sample.systemName << "::" << GetEventName(sample.event)
+					<< "\",\"cat\":\"" << GetEventName(sample.event)
+					<< "\",\"ph\":\"X\",\"ts\":" << sample.startMicroseconds
+					<< ",\"dur\":" << sample.durationMicroseconds
+					<< ",\"pid\":0,\"tid\":" << sample.threadIndex
+					<< ",\"args\":{\"entities\":" << sample.entityCount << ",\"frame\":" << frame << "}}";
+			}
+		}
+
+		file << "\n]}\n";
+		return file.good();
+	}
+
+	void Clear()
+	{
+		std::lock_guard<std::mutex> lock(framesMutex);
+		for (auto& frame : frames)
+		{
+			frame.clear();
+		}
+		frameCount = 0;
+	}
+
+	int64_t GetTimeMicroseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+	}
+};
+
+#endif
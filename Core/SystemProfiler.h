@@ -0,0 +1,109 @@
+#pragma once
+
+//Per-system timing of ActorSystem/ComponentSystem Tick, Init, Start, Serialise, Deserialise and Remove.
+//Define SYSTEM_PROFILER_ENABLED as 0 or 1 in the project to override the default (on in _DEBUG builds).
+//When disabled the macros below are empty and nothing in here is compiled.
+#ifndef SYSTEM_PROFILER_ENABLED
+#ifdef _DEBUG
+#define SYSTEM_PROFILER_ENABLED 1
+#else
+#define SYSTEM_PROFILER_ENABLED 0
+#endif
+#endif
+
+#if SYSTEM_PROFILER_ENABLED
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SystemProfiler
+{
+	enum class ProfileEvent : uint8_t
+	{
+		Tick,
+		Init,
+		Start,
+		Serialise,
+		Deserialise,
+		Remove,
+	};
+
+	const char* GetEventName(ProfileEvent event);
+
+	struct ProfileSample
+	{
+		//Points at the system's name, systems are static so it lives as long as the program.
+		const char* systemName = nullptr;
+		int64_t startMicroseconds = 0;
+		int64_t durationMicroseconds = 0;
+		uint32_t entityCount = 0;
+		uint32_t threadIndex = 0;
+		ProfileEvent event = ProfileEvent::Tick;
+	};
+
+	//One system's totals for one event over a frame.
+	struct SystemStats
+	{
+		std::string systemName;
+		ProfileEvent event = ProfileEvent::Tick;
+		uint32_t calls = 0;
+		uint32_t entityCount = 0;
+		int64_t totalMicroseconds = 0;
+	};
+
+	//Number of frames kept in the ring buffer.
+	inline constexpr uint32_t numFramesKept = 120;
+
+	//Starts a new frame in the ring buffer, overwriting the oldest one.
+	//Samples recorded outside of a frame (e.g. world loading) go to the current frame.
+	void BeginFrame();
+
+	void Record(const ProfileSample& sample);
+
+	//Totals per system and event for the last finished frame, slowest first.
+	std::vector<SystemStats> GetLastFrameStats();
+
+	//Writes every buffered frame as Chrome trace_event JSON (open with chrome://tracing or Perfetto).
+	bool ExportChromeTrace(const std::string& filename);
+
+	void Clear();
+
+	//Microseconds since the profiler's first use.
+	int64_t GetTimeMicroseconds();
+
+	class ScopedSystemTimer
+	{
+	public:
+		ScopedSystemTimer(const std::string& systemName, ProfileEvent event, size_t entityCount)
+		{
+			sample.systemName = systemName.c_str();
+			sample.event = event;
+			sample.entityCount = static_cast<uint32_t>(entityCount);
+			sample.startMicroseconds = GetTimeMicroseconds();
+		}
+
+		~ScopedSystemTimer()
+		{
+			sample.durationMicroseconds = GetTimeMicroseconds() - sample.startMicroseconds;
+			Record(sample);
+		}
+
+		ScopedSystemTimer(const ScopedSystemTimer&) = delete;
+		ScopedSystemTimer& operator=(const ScopedSystemTimer&) = delete;
+
+	private:
+		ProfileSample sample;
+	};
+};
+
+#define PROFILE_SYSTEM(systemName, event, entityCount) \
+SystemProfiler::ScopedSystemTimer systemProfileTimer(systemName, SystemProfiler::ProfileEvent::event, entityCount)
+#define PROFILE_BEGIN_FRAME() SystemProfiler::BeginFrame()
+
+#else
+
+#define PROFILE_SYSTEM(systemName, event, entityCount)
+#define PROFILE_BEGIN_FRAME()
+
+#endif
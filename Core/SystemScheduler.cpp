@@ -0,0 +1,238 @@
+#include "vpch.h"
+#include "SystemScheduler.h"
+#include <vector>
+#include <string>
+#include <set>
+#include <mutex>
+#include "JobSystem.h"
+#include "SystemProfiler.h"
+#include "TransformHierarchy.h"
+#include "AsyncWorldLoader.h"
+#include "Log.h"
+#include "Actors/IActorSystem.h"
+#include "Actors/ActorSystemCache.h"
+#include "Components/IComponentSystem.h"
+#include "Components/ComponentSystemCache.h"
+
+namespace SystemScheduler
+{
+	struct ScheduledSystem
+	{
+		IActorSystem* actorSystem = nullptr;
+		IComponentSystem* componentSystem = nullptr;
+		SystemAccess access;
+		uint32_t stage = 0;
+
+		std::string GetName() const
+		{
+			return actorSystem ? actorSystem->GetName() : componentSystem->GetName();
+		}
+
+		void Tick(float deltaTime) const
+		{
+			if (actorSystem)
+			{
+				actorSystem->Tick(deltaTime);
+			}
+			else
+			{
+				componentSystem->Tick(deltaTime);
+			}
+		}
+	};
+
+	std::vector<IActorSystem*> actorSystems;
+	std::vector<IComponentSystem*> componentSystems;
+
+	//Rebuilt every frame, kept around for DumpSchedule().
+	std::vector<ScheduledSystem> schedule;
+	std::vector<std::vector<uint32_t>> stages;
+
+#ifdef _DEBUG
+	bool accessChecking = true;
+#else
+	bool accessChecking = false;
+#endif
+
+	//The system being ticked on this thread, for CheckAccess().
+	thread_local const ScheduledSystem* currentSystem = nullptr;
+
+	std::mutex reportedAccessMutex;
+	std::set<std::pair<std::string, uint32_t>> reportedAccesses;
+
+	//Every system iterates its own actors/components, so all of them read the world's layout
+	//and anything that spawns or destroys (declared or by default) ticks on its own.
+	SystemAccess GetScheduledAccess(SystemAccess access)
+	{
+		access.reads |= SystemResources::WorldLayout;
+		return access;
+	}
+
+	void BuildSchedule()
+	{
+		//Systems are all static, only pick them up the once.
+		if (actorSystems.empty())
+		{
+			actorSystems = ActorSystemCache::Get().GetAllSystems();
+			componentSystems = ComponentSystemCache::Get().GetAllSystems();
+		}
+
+		schedule.clear();
+
+		for (IActorSystem* actorSystem : actorSystems)
+		{
+			if (actorSystem->GetNumActors() > 0)
+			{
+				ScheduledSystem& scheduledSystem = schedule.emplace_back();
+				scheduledSystem.actorSystem = actorSystem;
+				scheduledSystem.access = GetScheduledAccess(actorSystem->GetAccess());
+			}
+		}
+
+		for (IComponentSystem* componentSystem : componentSystems)
+		{
+			if (componentSystem->GetNumComponents() > 0)
+			{
+				ScheduledSystem& scheduledSystem = schedule.emplace_back();
+				scheduledSystem.componentSystem = componentSystem;
+				scheduledSystem.access = GetScheduledAccess(componentSystem->GetAccess());
+			}
+		}
+
+		//Each system depends on every earlier system it conflicts with, and goes one stage after the latest of them.
+		uint32_t numStages = 0;
+		for (size_t i = 0; i < schedule.size(); i++)
+		{
+			uint32_t stage = 0;
+			for (size_t j = 0; j < i; j++)
+			{
+				if (schedule[i].access.ConflictsWith(schedule[j].access))
+				{
+					stage = std::max(stage, schedule[j].stage + 1);
+				}
+			}
+
+			schedule[i].stage = stage;
+			numStages = std::max(numStages, stage + 1);
+		}
+
+		for (auto& stageSystems : stages)
+		{
+			stageSystems.clear();
+		}
+		stages.resize(numStages);
+
+		for (uint32_t i = 0; i < schedule.size(); i++)
+		{
+			stages[schedule[i].stage].emplace_back(i);
+		}
+
+#ifdef _DEBUG
+		for (const auto& stageSystems : stages)
+		{
+			for (size_t a = 0; a < stageSystems.size(); a++)
+			{
+				for (size_t b = a + 1; b < stageSystems.size(); b++)
+				{
+					assert(!schedule[stageSystems[a]].access.ConflictsWith(schedule[stageSystems[b]].access));
+				}
+			}
+		}
+#endif
+	}
+
+	void TickAllSystems(float deltaTime)
+	{
+		PROFILE_BEGIN_FRAME();
+
+		BuildSchedule();
+
+		for (const auto& stageSystems : stages)
+		{
+			if (stageSystems.size() == 1)
+			{
+				const ScheduledSystem& scheduledSystem = schedule[stageSystems.front()];
+				currentSystem = &scheduledSystem;
+				scheduledSystem.Tick(deltaTime);
+				currentSystem = nullptr;
+			}
+			else if (!stageSystems.empty())
+			{
+				JobSystem::ParallelFor(static_cast<uint32_t>(stageSystems.size()), 1, [&](uint32_t begin, uint32_t end) {
+					for (uint32_t i = begin; i < end; i++)
+					{
+						const ScheduledSystem& scheduledSystem = schedule[stageSystems[i]];
+						currentSystem = &scheduledSystem;
+						scheduledSystem.Tick(deltaTime);
+						currentSystem = nullptr;
+					}
+				});
+			}
+		}
+
+		//Destroyed actors are deactivated and skipped until then, one flush means one editor world list update.
+		ActorSystemCache::Get().FlushPendingRemoves();
+
+		//Nothing is ticking anymore, so a world queued to swap in mid frame can replace the systems now.
+		AsyncWorldLoader::RunQueuedSwap();
+
+		//Everything that moved this frame has, build world matrices for rendering in one go.
+		TransformHierarchy::Update();
+	}
+
+	void DumpSchedule()
+	{
+		Log("System schedule: %d systems in %d stages.", (int)schedule.size(), (int)stages.size());
+
+		for (size_t stageIndex = 0; stageIndex < stages.size(); stageIndex++)
+		{
+			std::string line;
+			for (uint32_t systemIndex : stages[stageIndex])
+			{
+				if (!line.empty())
+				{
+					line += ", ";
+				}
+				line += schedule[systemIndex].GetName();
+			}
+
+			Log("Stage %d: %s", (int)stageIndex, line.c_str());
+		}
+	}
+
+	void SetAccessChecking(bool enabled)
+	{
+		accessChecking = enabled;
+	}
+
+	void CheckAccess(uint32_t resource, bool write)
+	{
+		if (!accessChecking || currentSystem == nullptr)
+		{
+			return;
+		}
+
+		const SystemAccess& access = currentSystem->access;
+		const uint32_t allowed = write ? access.writes : (access.reads | access.writes);
+		if ((allowed & resource) == resource)
+		{
+			return;
+		}
+
+		const std::string systemName = currentSystem->GetName();
+		const uint32_t reportKey = resource | (write ? 0x80000000 : 0);
+
+		std::lock_guard<std::mutex> lock(reportedAccessMutex);
+		if (reportedAccesses.emplace(systemName, reportKey).second)
+		{
+			for (uint32_t resourceIndex = 0; resourceIndex < SystemResources::numResources; resourceIndex++)
+			{
+				if ((resource & ~allowed) & (1 << resourceIndex))
+				{
+					Log("System [%s] %s [%s] without declaring it in SYSTEM_ACCESS.", systemName.c_str(),
+						write ? "wrote" : "read", SystemResources::GetName(resourceIndex));
+				}
+			}
+		}
+	}
+}
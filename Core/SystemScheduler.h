@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include "SystemAccess.h"
+
+//Ticks every ActorSystem and ComponentSystem, overlapping systems whose declared SystemAccess doesn't conflict.
+//Each frame the systems are put into stages in system cache order (actor systems then component systems,
+//each by name). A system goes in the stage after the last earlier system it conflicts with, so conflicting
+//systems keep their serial order. Systems in the same stage tick across the JobSystem.
+//Queued actor removes are flushed once every stage has ticked.
+namespace SystemScheduler
+{
+	//Replaces ticking the actor and component systems in a serial loop.
+	void TickAllSystems(float deltaTime);
+
+	//Logs the stages built by the last TickAllSystems().
+	void DumpSchedule();
+
+	//Debug check that systems only touch the resources they declared. On by default in _DEBUG builds.
+	void SetAccessChecking(bool enabled);
+
+	//Logs the first time a system ticked by the scheduler touches a resource outside its SystemAccess.
+	//Call through SYSTEM_ACCESS_CHECK() so it compiles out of release builds.
+	void CheckAccess(uint32_t resource, bool write);
+};
+
+#ifdef _DEBUG
+#define SYSTEM_ACCESS_CHECK(resource, write) SystemScheduler::CheckAccess(resource, write)
+#else
+#define SYSTEM_ACCESS_CHECK(resource, write)
+#endif
@@ -0,0 +1,219 @@
+#include "vpch.h"
+#include "TransformHierarchy.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <DirectXMath.h>
+#include "JobSystem.h"
+#include "SystemProfiler.h"
+#include "Components/SpatialComponent.h"
+
+using namespace DirectX;
+
+namespace TransformHierarchy
+{
+	//Subtrees per job. Most are a single actor's handful of components.
+	constexpr uint32_t grainSize = 64;
+
+	const std::string profileName = "TransformHierarchy";
+
+	//Setters can be called from parallel ticks.
+	std::mutex queueMutex;
+	std::vector<SpatialComponent*> queue;
+
+	struct Subtree
+	{
+		SpatialComponent* root = nullptr;
+		XMMATRIX parentWorld;
+
+		//Range in the flat arrays, starting with the slot holding parentWorld.
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	std::vector<SpatialComponent*> updating;
+	std::vector<Subtree> subtrees;
+
+	//Every queued subtree laid out flat, parents before their children. Refilled each Update() from the
+	//subtrees that moved, components still own their transforms and get the results written back.
+	std::vector<SpatialComponent*> components; //nullptr for a subtree's parent world slot
+	std::vector<uint32_t> parentIndices;
+	std::vector<uint8_t> build;
+	std::vector<XMFLOAT3> positions;
+	std::vector<XMFLOAT4> rotations;
+	std::vector<XMFLOAT3> scales;
+	std::vector<XMMATRIX> worldMatrices;
+
+	Stats lastStats;
+
+	bool HasQueuedAncestor(SpatialComponent* component)
+	{
+		for (SpatialComponent* parent = component->GetParent(); parent; parent = parent->GetParent())
+		{
+			if (parent->GetUpdateQueueIndex() != SpatialComponent::notQueued)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	uint32_t AddSlot(SpatialComponent* component, uint32_t parentIndex, bool buildWorld, XMMATRIX world)
+	{
+		const uint32_t index = static_cast<uint32_t>(components.size());
+		components.emplace_back(component);
+		parentIndices.emplace_back(parentIndex);
+		build.emplace_back(buildWorld);
+		positions.emplace_back(buildWorld ? component->transform.position : XMFLOAT3());
+		rotations.emplace_back(buildWorld ? component->transform.rotation : XMFLOAT4());
+		scales.emplace_back(buildWorld ? component->transform.scale : XMFLOAT3());
+		worldMatrices.emplace_back(world);
+		return index;
+	}
+
+	//Clean components are walked through too, a GetWorldMatrix() read can leave them clean above dirty children.
+	//Clean ones only get a slot when they have children to pass their world matrix down to.
+	void Flatten(SpatialComponent* component, uint32_t parentIndex)
+	{
+		const bool buildWorld = build[parentIndex] || component->IsWorldMatrixStale();
+		if (!buildWorld && component->GetChildren().empty())
+		{
+			return;
+		}
+
+		const uint32_t index = AddSlot(component, parentIndex, buildWorld, component->transform.world);
+		for (SpatialComponent* child : component->GetChildren())
+		{
+			Flatten(child, index);
+		}
+	}
+
+	//Parents come first in the range, so one pass in order has every parent's world ready for its children.
+	uint32_t BuildRange(uint32_t begin, uint32_t end)
+	{
+		uint32_t numBuilt = 0;
+		const XMVECTOR rotationOrigin = XMVectorZero();
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			if (build[i] && components[i])
+			{
+				//Same as Transform::GetAffine()
+				const XMMATRIX local = XMMatrixAffineTransformation(XMLoadFloat3(&scales[i]), rotationOrigin,
+					XMLoadFloat4(&rotations[i]), XMLoadFloat3(&positions[i]));
+				worldMatrices[i] = local * worldMatrices[parentIndices[i]];
+			}
+		}
+
+		for (uint32_t i = begin; i < end; i++)
+		{
+			if (build[i] && components[i])
+			{
+				components[i]->SetCachedWorldMatrix(worldMatrices[i]);
+				numBuilt++;
+			}
+		}
+
+		return numBuilt;
+	}
+
+	void Update()
+	{
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			std::swap(queue, updating);
+		}
+
+		PROFILE_SYSTEM(profileName, Tick, updating.size());
+
+		//Queue indices are all still set here, so a parent anywhere up the chain is seen however the queue is ordered.
+		subtrees.clear();
+		for (SpatialComponent* component : updating)
+		{
+			if (!HasQueuedAncestor(component))
+			{
+				subtrees.push_back({ component, XMMatrixIdentity() });
+			}
+		}
+
+		for (SpatialComponent* component : updating)
+		{
+			component->SetUpdateQueueIndex(SpatialComponent::notQueued);
+		}
+		updating.clear();
+
+		components.clear();
+		parentIndices.clear();
+		build.clear();
+		positions.clear();
+		rotations.clear();
+		scales.clear();
+		worldMatrices.clear();
+
+		//Parents above a subtree aren't queued so they're usually clean, but a direct write up there is
+		//resolved here on the main thread rather than by two jobs at once.
+		for (Subtree& subtree : subtrees)
+		{
+			if (SpatialComponent* parent = subtree.root->GetParent())
+			{
+				subtree.parentWorld = parent->GetWorldMatrix();
+			}
+
+			subtree.begin = AddSlot(nullptr, 0, false, subtree.parentWorld);
+			build.back() = true; //So the root is always built
+			Flatten(subtree.root, subtree.begin);
+			subtree.end = static_cast<uint32_t>(components.size());
+		}
+
+		std::atomic<uint32_t> numBuilt = 0;
+
+		//Subtrees don't overlap, each one's range is built on its own.
+		JobSystem::ParallelFor(static_cast<uint32_t>(subtrees.size()), grainSize, [&](uint32_t begin, uint32_t end) {
+			uint32_t rangeBuilt = 0;
+			for (uint32_t i = begin; i < end; i++)
+			{
+				rangeBuilt += BuildRange(subtrees[i].begin, subtrees[i].end);
+			}
+			numBuilt += rangeBuilt;
+		});
+
+		lastStats.numSubtrees = static_cast<uint32_t>(subtrees.size());
+		lastStats.numBuilt = numBuilt;
+	}
+
+	void Enqueue(SpatialComponent* component)
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		if (component->GetUpdateQueueIndex() != SpatialComponent::notQueued)
+		{
+			return;
+		}
+
+		component->SetUpdateQueueIndex(static_cast<uint32_t>(queue.size()));
+		queue.push_back(component);
+	}
+
+	void Dequeue(SpatialComponent* component)
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+
+		const uint32_t index = component->GetUpdateQueueIndex();
+		if (index == SpatialComponent::notQueued)
+		{
+			return;
+		}
+
+		SpatialComponent* last = queue.back();
+		queue[index] = last;
+		last->SetUpdateQueueIndex(index);
+		queue.pop_back();
+
+		component->SetUpdateQueueIndex(SpatialComponent::notQueued);
+	}
+
+	const Stats& GetLastStats()
+	{
+		return lastStats;
+	}
+};
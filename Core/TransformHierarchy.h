@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+class SpatialComponent;
+
+//Builds the world matrices of everything that moved this frame in one pass, instead of each one being built
+//on whichever read happens to come first mid frame.
+//
+//Transform setters queue the component they were called on (SpatialComponent::MarkWorldDirty()). Update() takes
+//the queue and drops components that have a queued parent further up. The subtrees under the rest are copied
+//into flat position/rotation/scale arrays, parents before children, and each subtree's range is built in one
+//linear pass across the JobSystem before the results are written back to the components. Nothing that didn't
+//move is copied, so a frame where nothing moved costs next to nothing.
+//
+//The arrays are refilled each Update() rather than holding the transforms, props, the editor and world loading
+//all write to components directly and GetWorldMatrix() builds lazily in between Update()s. Writes straight to
+//transform aren't queued and are picked up on the next GetWorldMatrix().
+namespace TransformHierarchy
+{
+	struct Stats
+	{
+		//Subtrees built by the last Update(), after dropping ones under another queued component.
+		uint32_t numSubtrees = 0;
+
+		//World matrices built by the last Update().
+		uint32_t numBuilt = 0;
+	};
+
+	//Call once a frame from outside of system ticks, SystemScheduler does after the last stage.
+	void Update();
+
+	//Only SpatialComponent queues and dequeues itself, see SpatialComponent::MarkWorldDirty().
+	//Both do nothing if the component is already queued or not queued.
+	void Enqueue(SpatialComponent* component);
+	void Dequeue(SpatialComponent* component);
+
+	const Stats& GetLastStats();
+};
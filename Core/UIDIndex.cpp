@@ -0,0 +1,62 @@
+#include "vpch.h"
+#include "UIDIndex.h"
+#include "UIDMap.h"
+#include "Actors/Actor.h"
+#include "Components/Component.h"
+#include "Components/IComponentSystem.h"
+#include "Components/ComponentSystemCache.h"
+
+static UIDMap<Actor> actorsByUID;
+static UIDMap<Component> componentsByUID;
+
+void UIDIndex::AddActor(Actor* actor)
+{
+	actorsByUID.Insert(static_cast<uint64_t>(actor->GetUID()), actor);
+}
+
+void UIDIndex::RemoveActor(Actor* actor)
+{
+	//Don't remove an entry another actor has since claimed
+	const uint64_t key = static_cast<uint64_t>(actor->GetUID());
+	if (actorsByUID.Find(key) == actor)
+	{
+		actorsByUID.Remove(key);
+	}
+}
+
+Actor* UIDIndex::FindActor(UID uid)
+{
+	return actorsByUID.Find(static_cast<uint64_t>(uid));
+}
+
+void UIDIndex::ReserveActors(size_t count)
+{
+	actorsByUID.Reserve(actorsByUID.Size() + count);
+}
+
+void UIDIndex::AddComponent(Component* component)
+{
+	componentsByUID.Insert(static_cast<uint64_t>(component->GetUID()), component);
+}
+
+void UIDIndex::RemoveComponent(Component* component)
+{
+	const uint64_t key = static_cast<uint64_t>(component->GetUID());
+	if (componentsByUID.Find(key) == component)
+	{
+		componentsByUID.Remove(key);
+	}
+}
+
+Component* UIDIndex::FindComponent(UID uid)
+{
+	return componentsByUID.Find(static_cast<uint64_t>(uid));
+}
+
+void UIDIndex::RelinkAllComponentsToOwners()
+{
+	for (IComponentSystem* componentSystem : ComponentSystemCache::Get().GetAllSystems())
+	{
+		componentSystem->RelinkComponentsToOwners();
+	}
+}
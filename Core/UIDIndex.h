@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Core/UID.h"
+
+class Actor;
+class Component;
+
+//World wide UID lookups for actors and components.
+//ActorSystem and ComponentSystem register on Add() and unregister on Remove()/Cleanup(),
+//and reregister on Deserialise() as UIDs are read in through Properties.
+namespace UIDIndex
+{
+	void AddActor(Actor* actor);
+	void RemoveActor(Actor* actor);
+	Actor* FindActor(UID uid);
+
+	//Sizes the actor table for count more actors, see ActorSystem::AddBatch().
+	void ReserveActors(size_t count);
+
+	void AddComponent(Component* component);
+	void RemoveComponent(Component* component);
+	Component* FindComponent(UID uid);
+
+	//Attaches every component with an owner UID but no owner to that actor.
+	//Call once after a world's actors and components have been deserialised.
+	void RelinkAllComponentsToOwners();
+};
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+//Open addressing hash map from a UID to a pointer, used for the world wide UID lookups in UIDIndex.
+//Linear probing over a power of two table. Remove() leaves a tombstone that is dropped on the next rehash.
+//UID 0 means "no UID" across the engine and can't be used as a key.
+template <typename T>
+class UIDMap
+{
+public:
+	void Insert(uint64_t key, T* value)
+	{
+		assert(key != emptyKey && key != tombstoneKey);
+
+		if ((numLive + numTombstones + 1) * 4 > slots.size() * 3)
+		{
+			Rehash(numLive + 1);
+		}
+
+		size_t insertIndex = SIZE_MAX;
+		size_t index = Hash(key) & (slots.size() - 1);
+
+		while (slots[index].key != emptyKey)
+		{
+			if (slots[index].key == key)
+			{
+				slots[index].value = value;
+				return;
+			}
+
+			if (slots[index].key == tombstoneKey && insertIndex == SIZE_MAX)
+			{
+				insertIndex = index;
+			}
+
+			index = (index + 1) & (slots.size() - 1);
+		}
+
+		if (insertIndex == SIZE_MAX)
+		{
+			insertIndex = index;
+		}
+		else
+		{
+			numTombstones--;
+		}
+
+		slots[insertIndex].key = key;
+		slots[insertIndex].value = value;
+		numLive++;
+	}
+
+	T* Find(uint64_t key) const
+	{
+		const size_t index = FindSlot(key);
+		if (index == SIZE_MAX)
+		{
+			return nullptr;
+		}
+
+		return slots[index].value;
+	}
+
+	bool Remove(uint64_t key)
+	{
+		const size_t index = FindSlot(key);
+		if (index == SIZE_MAX)
+		{
+			return false;
+		}
+
+		slots[index].key = tombstoneKey;
+		slots[index].value = nullptr;
+		numLive--;
+		numTombstones++;
+
+		return true;
+	}
+
+	//Sizes the table up front for a known number of entries, e.g. before a world load.
+	void Reserve(size_t count)
+	{
+		if ((count + numTombstones) * 4 > slots.size() * 3)
+		{
+			Rehash(count);
+		}
+	}
+
+	void Clear()
+	{
+		slots.clear();
+		numLive = 0;
+		numTombstones = 0;
+	}
+
+	size_t Size() const { return numLive; }
+
+private:
+	static constexpr uint64_t emptyKey = 0;
+	static constexpr uint64_t tombstoneKey = UINT64_MAX;
+
+	struct Slot
+	{
+		uint64_t key = emptyKey;
+		T* value = nullptr;
+	};
+
+	//splitmix64 finaliser, UIDs aren't guaranteed to be well spread in their low bits.
+	static uint64_t Hash(uint64_t key)
+	{
+		key ^= key >> 30;
+		key *= 0xbf58476d1ce4e5b9ull;
+		key ^= key >> 27;
+		key *= 0x94d049bb133111ebull;
+		key ^= key >> 31;
+		return key;
+	}
+
+	size_t FindSlot(uint64_t key) const
+	{
+		if (slots.empty() || key == emptyKey || key == tombstoneKey)
+		{
+			return SIZE_MAX;
+		}
+
+		size_t index = Hash(key) & (slots.size() - 1);
+		while (slots[index].key != emptyKey)
+		{
+			if (slots[index].key == key)
+			{
+				return index;
+			}
+
+			index = (index + 1) & (slots.size() - 1);
+		}
+
+		return SIZE_MAX;
+	}
+
+	//Rebuilds the table with room for at least count entries under a 75% load, dropping tombstones.
+	void Rehash(size_t count)
+	{
+		size_t capacity = 16;
+		while (count * 4 > capacity * 3)
+		{
+			capacity *= 2;
+		}
+
+		std::vector<Slot> oldSlots(capacity);
+		oldSlots.swap(slots);
+
+		numLive = 0;
+		numTombstones = 0;
+
+		for (const Slot& slot : oldSlots)
+		{
+			if (slot.key != emptyKey && slot.key != tombstoneKey)
+			{
+				size_t index = Hash(slot.key) & (capacity - 1);
+				while (slots[index].key != emptyKey)
+				{
+					index = (index + 1) & (capacity - 1);
+				}
+
+				slots[index] = slot;
+				numLive++;
+			}
+		}
+	}
+
+	std::vector<Slot> slots;
+	size_t numLive = 0;
+	size_t numTombstones = 0;
+};
@@ -0,0 +1,188 @@
+#include "vpch.h"
+#include "WorldCache.h"
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "Log.h"
+#include "World.h"
+#include "Camera.h"
+#include "WorldDelta.h"
+#include "Actors/Actor.h"
+#include "Actors/IActorSystem.h"
+#include "Actors/ActorSystemCache.h"
+#include "Components/Component.h"
+#include "Components/IComponentSystem.h"
+#include "Components/ComponentSystemCache.h"
+#include "Components/CameraComponent.h"
+#include "Gameplay/GameUtils.h"
+
+namespace WorldCache
+{
+	struct SuspendedWorld
+	{
+		std::string worldName;
+		std::vector<std::pair<IActorSystem*, std::unique_ptr<DetachedSystem>>> actorSystems;
+		std::vector<std::pair<IComponentSystem*, std::unique_ptr<DetachedSystem>>> componentSystems;
+		WorldDelta::TrackingState tracking;
+		CameraComponent* activeCamera = nullptr;
+		size_t memorySize = 0;
+	};
+
+	//Most recently left first.
+	std::list<SuspendedWorld> suspendedWorlds;
+
+	uint32_t maxWorlds = 3;
+	size_t memoryBudget = 128 * 1024 * 1024;
+
+	auto FindWorld(const std::string& worldName)
+	{
+		return std::find_if(suspendedWorlds.begin(), suspendedWorlds.end(),
+			[&worldName](const SuspendedWorld& world) { return world.worldName == worldName; });
+	}
+
+	//Dropping a world destroys its actors and components the same as a system Cleanup() would.
+	void EvictOverCapacity()
+	{
+		while (!suspendedWorlds.empty()
+			&& (suspendedWorlds.size() > maxWorlds || GetMemorySize() > memoryBudget))
+		{
+			Log("WorldCache: dropped [%s].", suspendedWorlds.back().worldName.c_str());
+			suspendedWorlds.pop_back();
+		}
+	}
+
+	void SetCapacity(uint32_t maxWorlds_, size_t memoryBudget_)
+	{
+		maxWorlds = maxWorlds_;
+		memoryBudget = memoryBudget_;
+		EvictOverCapacity();
+	}
+
+	bool Contains(const std::string& worldName)
+	{
+		return FindWorld(worldName) != suspendedWorlds.end();
+	}
+
+	void SuspendCurrentWorld()
+	{
+		//Destroyed actors aren't worth keeping.
+		ActorSystemCache::Get().FlushPendingRemoves();
+
+		SuspendedWorld world;
+		world.worldName = World::worldFilename;
+		world.activeCamera = activeCamera;
+
+		for (IComponentSystem* componentSystem : ComponentSystemCache::Get().GetAllSystems())
+		{
+			if (componentSystem->GetNumComponents() == 0)
+			{
+				continue;
+			}
+
+			for (Component* component : componentSystem->GetComponentsAsBaseClass())
+			{
+				component->OnWorldSuspended();
+			}
+
+			auto& detached = world.componentSystems.emplace_back(componentSystem, componentSystem->Detach());
+			world.memorySize += detached.second->GetMemorySize();
+		}
+
+		for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+		{
+			if (actorSystem->GetNumActors() == 0)
+			{
+				continue;
+			}
+
+			for (Actor* actor : actorSystem->GetActorsAsBaseClass())
+			{
+				actor->OnWorldSuspended();
+			}
+
+			auto& detached = world.actorSystems.emplace_back(actorSystem, actorSystem->Detach());
+			world.memorySize += detached.second->GetMemorySize();
+		}
+
+		world.tracking = WorldDelta::SuspendTracking();
+
+		//Leaving the same world twice (e.g. it was reloaded from disk in between) keeps the latest.
+		auto existingIt = FindWorld(world.worldName);
+		if (existingIt != suspendedWorlds.end())
+		{
+			suspendedWorlds.erase(existingIt);
+		}
+
+		suspendedWorlds.emplace_front(std::move(world));
+		EvictOverCapacity();
+	}
+
+	bool Resume(const std::string& worldName)
+	{
+		auto worldIt = FindWorld(worldName);
+		if (worldIt == suspendedWorlds.end())
+		{
+			return false;
+		}
+
+		SuspendedWorld& world = *worldIt;
+
+		//Actors first so components find their owners through UIDIndex.
+		for (auto& [actorSystem, detached] : world.actorSystems)
+		{
+			actorSystem->Reattach(std::move(detached));
+		}
+
+		for (auto& [componentSystem, detached] : world.componentSystems)
+		{
+			componentSystem->Reattach(std::move(detached));
+
+			for (Component* component : componentSystem->GetComponentsAsBaseClass())
+			{
+				component->OnWorldResumed();
+			}
+		}
+
+		World::worldFilename = world.worldName;
+		WorldDelta::ResumeTracking(std::move(world.tracking));
+
+		if (world.activeCamera)
+		{
+			GameUtils::SetActiveCamera(world.activeCamera);
+		}
+
+		//Once everything is back, actors resetting themselves might look up others.
+		for (auto& [actorSystem, detached] : world.actorSystems)
+		{
+			for (Actor* actor : actorSystem->GetActorsAsBaseClass())
+			{
+				actor->OnWorldResumed();
+			}
+		}
+
+		suspendedWorlds.erase(worldIt);
+		return true;
+	}
+
+	void Clear()
+	{
+		suspendedWorlds.clear();
+	}
+
+	uint32_t GetNumWorlds()
+	{
+		return static_cast<uint32_t>(suspendedWorlds.size());
+	}
+
+	size_t GetMemorySize()
+	{
+		size_t memorySize = 0;
+		for (const SuspendedWorld& world : suspendedWorlds)
+		{
+			memorySize += world.memorySize;
+		}
+		return memorySize;
+	}
+};
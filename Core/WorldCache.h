@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//A system's actors or components taken out of it with Detach(), see IActorSystem/IComponentSystem.
+//Everything stays alive as is (GPU buffers, handles, etc.), it just isn't in the system to be ticked or found.
+class DetachedSystem
+{
+public:
+	virtual ~DetachedSystem() {}
+
+	//Rough size of what's held, for WorldCache's budget.
+	virtual size_t GetMemorySize() const = 0;
+};
+
+//Keeps recently left worlds suspended in memory so walking back into one reattaches it instead of loading it again.
+//
+//SuspendCurrentWorld() detaches every system's actors and components, releases their physics actors
+//(Component::OnWorldSuspended()) and sets the world's game save tracking aside (WorldDelta::SuspendTracking()).
+//Resume() puts all of that back, the world carries on as it was left without Start() or world start functions
+//running again. Actors reset per visit state in Actor::OnWorldResumed(). World state reading GameInstance does so live, so global state changed elsewhere is picked up.
+//
+//Least recently left worlds are dropped past the world count or memory budget. Clear() when GameInstance
+//or game saves are reloaded, cached worlds would otherwise be out of step with them.
+namespace WorldCache
+{
+	void SetCapacity(uint32_t maxWorlds, size_t memoryBudget);
+
+	bool Contains(const std::string& worldName);
+
+	//Moves the loaded world (World::worldFilename) into the cache, leaving every system empty.
+	//Call from outside of system ticks.
+	void SuspendCurrentWorld();
+
+	//Reattaches a cached world. Every system has to be empty, see SuspendCurrentWorld().
+	bool Resume(const std::string& worldName);
+
+	void Clear();
+
+	uint32_t GetNumWorlds();
+	size_t GetMemorySize();
+};
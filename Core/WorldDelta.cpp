@@ -0,0 +1,585 @@
+#include "vpch.h"
+#include "WorldDelta.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Log.h"
+#include "PropsSchema.h"
+#include "UIDIndex.h"
+#include "Actors/Actor.h"
+#include "Actors/ActorHandle.h"
+#include "Actors/IActorSystem.h"
+#include "Actors/ActorSystemCache.h"
+#include "Components/Component.h"
+#include "Components/IComponentSystem.h"
+#include "Components/ComponentSystemCache.h"
+
+namespace WorldDelta
+{
+	//baseActors are the actors the base world loaded with, destroying one of these leaves a tombstone.
+	//dirtyActors are handles instead of UIDs, spawned actors take their UID from records after they've been flagged.
+	TrackingState state;
+
+	//Actors are only added once (see Actor::MarkSaveDirty()) but PARALLEL_TICK actors can flag themselves.
+	//Also guards tombstones.
+	std::mutex dirtyActorsMutex;
+
+	//Hash of everything Save() would write for the actor. Types Save() can't write are left out, it fails on those anyway.
+	size_t HashRecords(Actor* actor)
+	{
+		PackedRecords records;
+
+		IActorSystem* actorSystem = actor->GetActorSystem();
+		if (actorSystem->GetPropsSchema().IsRecordable())
+		{
+			actorSystem->WriteRecord(records, actor);
+		}
+
+		for (Component* component : actor->GetAllComponents())
+		{
+			IComponentSystem* componentSystem = component->GetComponentSystem();
+			if (componentSystem->GetPropsSchema().IsRecordable())
+			{
+				componentSystem->WriteRecord(records, component);
+			}
+		}
+
+		return std::hash<std::string_view>{}(records.GetBytes());
+	}
+
+	//Flags base actors whose props were written without MarkSaveDirty() since tracking began.
+	void MarkChangedActorsDirty()
+	{
+		for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+		{
+			for (uint32_t i = 0; i < actorSystem->GetNumActors(); i++)
+			{
+				Actor* actor = actorSystem->GetActorByIndex(i);
+				if (actor->IsSaveDirty() || actor->IsPendingDestroy())
+				{
+					continue;
+				}
+
+				auto baseIt = state.baseActors.find(static_cast<uint64_t>(actor->GetUID()));
+				if (baseIt != state.baseActors.end() && baseIt->second != HashRecords(actor))
+				{
+					actor->MarkSaveDirty();
+				}
+			}
+		}
+	}
+
+	void BeginTracking(const std::string& baseWorldFilename)
+	{
+		EndTracking();
+
+		state.baseWorldFilename = baseWorldFilename;
+
+		for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+		{
+			for (uint32_t i = 0; i < actorSystem->GetNumActors(); i++)
+			{
+				Actor* actor = actorSystem->GetActorByIndex(i);
+				actor->ClearSaveDirty();
+				state.baseActors.emplace(static_cast<uint64_t>(actor->GetUID()), HashRecords(actor));
+			}
+		}
+
+		state.tracking = true;
+	}
+
+	void EndTracking()
+	{
+		for (const ActorHandle<Actor>& handle : state.dirtyActors)
+		{
+			if (Actor* actor = handle.Get())
+			{
+				actor->ClearSaveDirty();
+			}
+		}
+
+		state.tracking = false;
+		state.baseWorldFilename.clear();
+		state.baseActors.clear();
+		state.tombstones.clear();
+		state.dirtyActors.clear();
+	}
+
+	bool IsTracking()
+	{
+		return state.tracking;
+	}
+
+	TrackingState SuspendTracking()
+	{
+		TrackingState suspended = std::move(state);
+		state = TrackingState();
+		return suspended;
+	}
+
+	void ResumeTracking(TrackingState&& resumed)
+	{
+		state = std::move(resumed);
+	}
+
+	void OnActorDirtied(Actor* actor)
+	{
+		std::lock_guard<std::mutex> lock(dirtyActorsMutex);
+		state.dirtyActors.emplace_back(actor);
+	}
+
+	void OnActorSpawned(Actor* actor)
+	{
+		actor->MarkSaveDirty();
+	}
+
+	void OnActorRemoved(Actor* actor)
+	{
+		if (!state.tracking)
+		{
+			return;
+		}
+
+		const uint64_t uid = static_cast<uint64_t>(actor->GetUID());
+		if (state.baseActors.contains(uid))
+		{
+			//Destroy() is allowed from parallel ticks too.
+			std::lock_guard<std::mutex> lock(dirtyActorsMutex);
+			state.tombstones.emplace(uid);
+		}
+	}
+
+	template <typename System, typename Object>
+	void AddToSystemGroup(std::vector<System*>& systems, std::unordered_map<System*, std::vector<Object*>>& groups,
+		System* system, Object* object)
+	{
+		std::vector<Object*>& group = groups[system];
+		if (group.empty())
+		{
+			systems.emplace_back(system);
+		}
+		group.emplace_back(object);
+	}
+
+	bool CheckRecordable(const std::string& systemName, const PropsSchema& schema)
+	{
+		if (schema.IsRecordable())
+		{
+			return true;
+		}
+
+		for (const std::string& fieldName : schema.GetUnrecordableFields())
+		{
+			Log("WorldDelta: [%s] property [%s] has no record type, register a codec with PropsSchema::RegisterFieldCodec().",
+				systemName.c_str(), fieldName.c_str());
+		}
+
+		return false;
+	}
+
+	bool Save(const std::string& filename)
+	{
+		if (!state.tracking)
+		{
+			return false;
+		}
+
+		MarkChangedActorsDirty();
+
+		//Grouped by system in the order they were first dirtied, each group is one section.
+		std::vector<IActorSystem*> actorSystems;
+		std::unordered_map<IActorSystem*, std::vector<Actor*>> actorsBySystem;
+		std::vector<IComponentSystem*> componentSystems;
+		std::unordered_map<IComponentSystem*, std::vector<Component*>> componentsBySystem;
+
+		for (const ActorHandle<Actor>& handle : state.dirtyActors)
+		{
+			Actor* actor = handle.Get();
+			if (actor == nullptr || actor->IsPendingDestroy())
+			{
+				continue;
+			}
+
+			AddToSystemGroup(actorSystems, actorsBySystem, actor->GetActorSystem(), actor);
+
+			for (Component* component : actor->GetAllComponents())
+			{
+				AddToSystemGroup(componentSystems, componentsBySystem, component->GetComponentSystem(), component);
+			}
+		}
+
+		bool allRecordable = true;
+		for (IActorSystem* actorSystem : actorSystems)
+		{
+			allRecordable &= CheckRecordable(actorSystem->GetName(), actorSystem->GetPropsSchema());
+		}
+		for (IComponentSystem* componentSystem : componentSystems)
+		{
+			allRecordable &= CheckRecordable(componentSystem->GetName(), componentSystem->GetPropsSchema());
+		}
+
+		if (!allRecordable)
+		{
+			return false;
+		}
+
+		PackedRecords records;
+
+		Header header;
+		header.numTombstones = static_cast<uint32_t>(state.tombstones.size());
+		header.numActorSections = static_cast<uint32_t>(actorSystems.size());
+		header.numComponentSections = static_cast<uint32_t>(componentSystems.size());
+		records.Write(header);
+		records.WriteString(state.baseWorldFilename);
+
+		for (uint64_t uid : state.tombstones)
+		{
+			records.Write(uid);
+		}
+
+		for (IActorSystem* actorSystem : actorSystems)
+		{
+			const std::vector<Actor*>& actors = actorsBySystem[actorSystem];
+
+			records.WriteString(actorSystem->GetName());
+			records.Write(static_cast<uint32_t>(actors.size()));
+			for (Actor* actor : actors)
+			{
+				records.Write(static_cast<uint64_t>(actor->GetUID()));
+			}
+
+			actorSystem->WriteRecords(records, actors);
+		}
+
+		for (IComponentSystem* componentSystem : componentSystems)
+		{
+			const std::vector<Component*>& components = componentsBySystem[componentSystem];
+
+			records.WriteString(componentSystem->GetName());
+			records.Write(static_cast<uint32_t>(components.size()));
+			for (Component* component : components)
+			{
+				records.Write(static_cast<uint64_t>(component->GetOwnerUID()));
+				records.WriteString(component->name);
+			}
+
+			componentSystem->WriteRecords(records, components);
+		}
+
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			Log("WorldDelta: couldn't open [%s] for writing.", filename.c_str());
+			return false;
+		}
+
+		file.write(records.GetBytes().data(), records.GetBytes().size());
+		return file.good();
+	}
+
+	//Reads through everything after the base world filename without touching the world, so Apply() only starts
+	//destroying and spawning once it knows every section can be applied.
+	bool CheckSections(PackedRecords& records, const Header& header, const std::string& filename)
+	{
+		for (uint32_t i = 0; i < header.numTombstones; i++)
+		{
+			uint64_t uid = 0;
+			if (!records.Read(uid))
+			{
+				Log("WorldDelta: [%s] tombstones are truncated.", filename.c_str());
+				return false;
+			}
+		}
+
+		for (uint32_t i = 0; i < header.numActorSections; i++)
+		{
+			std::string systemName;
+			uint32_t numActors = 0;
+			if (!records.ReadString(systemName) || !records.Read(numActors))
+			{
+				Log("WorldDelta: [%s] actor section %u is truncated.", filename.c_str(), i);
+				return false;
+			}
+
+			//Records can't be read without the system's schema, so a missing system fails the whole delta.
+			if (ActorSystemCache::Get().GetSystem(systemName) == nullptr)
+			{
+				Log("WorldDelta: [%s] has no actor system [%s].", filename.c_str(), systemName.c_str());
+				return false;
+			}
+
+			for (uint32_t actorIndex = 0; actorIndex < numActors; actorIndex++)
+			{
+				uint64_t uid = 0;
+				if (!records.Read(uid))
+				{
+					Log("WorldDelta: [%s] actor section %u is truncated.", filename.c_str(), i);
+					return false;
+				}
+			}
+
+			if (!PropsSchema::SkipRecords(records, numActors))
+			{
+				Log("WorldDelta: [%s] actor section %u records are truncated.", filename.c_str(), i);
+				return false;
+			}
+		}
+
+		for (uint32_t i = 0; i < header.numComponentSections; i++)
+		{
+			std::string systemName;
+			uint32_t numComponents = 0;
+			if (!records.ReadString(systemName) || !records.Read(numComponents))
+			{
+				Log("WorldDelta: [%s] component section %u is truncated.", filename.c_str(), i);
+				return false;
+			}
+
+			if (ComponentSystemCache::Get().GetSystem(systemName) == nullptr)
+			{
+				Log("WorldDelta: [%s] has no component system [%s].", filename.c_str(), systemName.c_str());
+				return false;
+			}
+
+			for (uint32_t componentIndex = 0; componentIndex < numComponents; componentIndex++)
+			{
+				uint64_t ownerUID = 0;
+				std::string componentName;
+				if (!records.Read(ownerUID) || !records.ReadString(componentName))
+				{
+					Log("WorldDelta: [%s] component section %u is truncated.", filename.c_str(), i);
+					return false;
+				}
+			}
+
+			if (!PropsSchema::SkipRecords(records, numComponents))
+			{
+				Log("WorldDelta: [%s] component section %u records are truncated.", filename.c_str(), i);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool ApplyActorSection(PackedRecords& records, std::vector<Actor*>& spawnedActors)
+	{
+		std::string systemName;
+		uint32_t numActors = 0;
+		if (!records.ReadString(systemName) || !records.Read(numActors))
+		{
+			return false;
+		}
+
+		//Records can't be skipped without the system's schema, so a missing system ends the apply.
+		IActorSystem* actorSystem = ActorSystemCache::Get().GetSystem(systemName);
+		if (actorSystem == nullptr)
+		{
+			Log("WorldDelta: no actor system [%s].", systemName.c_str());
+			return false;
+		}
+
+		std::vector<Actor*> targets;
+		targets.reserve(numActors);
+
+		for (uint32_t i = 0; i < numActors; i++)
+		{
+			uint64_t uid = 0;
+			if (!records.Read(uid))
+			{
+				return false;
+			}
+
+			//Actors not in the base world were spawned during play.
+			Actor* actor = UIDIndex::FindActor(static_cast<UID>(uid));
+			if (actor == nullptr || actor->GetActorSystem() != actorSystem)
+			{
+				actor = actorSystem->SpawnActor(Transform());
+				spawnedActors.emplace_back(actor);
+			}
+
+			actor->MarkSaveDirty();
+			targets.emplace_back(actor);
+		}
+
+		actorSystem->ReadRecords(records, targets);
+		return true;
+	}
+
+	bool ApplyComponentSection(PackedRecords& records, std::vector<Component*>& spawnedComponents)
+	{
+		std::string systemName;
+		uint32_t numComponents = 0;
+		if (!records.ReadString(systemName) || !records.Read(numComponents))
+		{
+			return false;
+		}
+
+		IComponentSystem* componentSystem = ComponentSystemCache::Get().GetSystem(systemName);
+		if (componentSystem == nullptr)
+		{
+			Log("WorldDelta: no component system [%s].", systemName.c_str());
+			return false;
+		}
+
+		std::vector<Component*> targets;
+		targets.reserve(numComponents);
+
+		for (uint32_t i = 0; i < numComponents; i++)
+		{
+			uint64_t ownerUID = 0;
+			std::string componentName;
+			if (!records.Read(ownerUID) || !records.ReadString(componentName))
+			{
+				return false;
+			}
+
+			Actor* owner = UIDIndex::FindActor(static_cast<UID>(ownerUID));
+
+			//Components created in the owner's constructor already exist, fill those in.
+			Component* component = owner ? owner->GetComponentByName(componentName) : nullptr;
+			if (component == nullptr || component->GetComponentSystem() != componentSystem)
+			{
+				//Named before it's added to the owner, actors index their components by name.
+				component = componentSystem->SpawnComponent(nullptr);
+				component->name = componentName;
+
+				if (owner)
+				{
+					owner->AddComponent(component);
+				}
+				else
+				{
+					component->SetOwnerUID(static_cast<UID>(ownerUID));
+				}
+
+				spawnedComponents.emplace_back(component);
+			}
+
+			targets.emplace_back(component);
+		}
+
+		componentSystem->ReadRecords(records, targets);
+		return true;
+	}
+
+	bool Apply(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::in | std::ios::binary);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		const std::string bytes{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+		PackedRecords records(bytes.data(), bytes.size());
+
+		Header header;
+		if (!records.Read(header) || header.magic != magic)
+		{
+			Log("WorldDelta: [%s] isn't a valid delta save.", filename.c_str());
+			return false;
+		}
+
+		if (header.version != version)
+		{
+			Log("WorldDelta: version %u isn't supported, expected %u.", header.version, version);
+			return false;
+		}
+
+		std::string savedBaseWorldFilename;
+		if (!records.ReadString(savedBaseWorldFilename) || savedBaseWorldFilename != state.baseWorldFilename)
+		{
+			Log("WorldDelta: [%s] was saved against [%s], not [%s].", filename.c_str(),
+				savedBaseWorldFilename.c_str(), state.baseWorldFilename.c_str());
+			return false;
+		}
+
+		//Checked on a second read through the same bytes, records then picks up where the check started.
+		{
+			PackedRecords checkRecords(bytes.data(), bytes.size());
+			Header checkHeader;
+			std::string checkBaseWorldFilename;
+			checkRecords.Read(checkHeader);
+			checkRecords.ReadString(checkBaseWorldFilename);
+
+			if (!CheckSections(checkRecords, header, filename))
+			{
+				return false;
+			}
+		}
+
+		for (uint32_t i = 0; i < header.numTombstones; i++)
+		{
+			uint64_t uid = 0;
+			records.Read(uid);
+
+			//Kept even if the actor is already gone so the next save still has it.
+			state.tombstones.emplace(uid);
+
+			if (Actor* actor = UIDIndex::FindActor(static_cast<UID>(uid)))
+			{
+				actor->GetActorSystem()->RemoveInterfaceActor(actor);
+			}
+		}
+
+		ActorSystemCache::Get().FlushPendingRemoves();
+
+		std::vector<Actor*> spawnedActors;
+		for (uint32_t i = 0; i < header.numActorSections; i++)
+		{
+			if (!ApplyActorSection(records, spawnedActors))
+			{
+				Log("WorldDelta: [%s] actor section %u couldn't be applied.", filename.c_str(), i);
+				return false;
+			}
+		}
+
+		//Components added in constructors took the UID the actors had before their records were read.
+		for (Actor* actor : spawnedActors)
+		{
+			for (Component* component : actor->GetAllComponents())
+			{
+				component->SetOwnerUID(actor->GetUID());
+			}
+		}
+
+		std::vector<Component*> spawnedComponents;
+		for (uint32_t i = 0; i < header.numComponentSections; i++)
+		{
+			if (!ApplyComponentSection(records, spawnedComponents))
+			{
+				Log("WorldDelta: [%s] component section %u couldn't be applied.", filename.c_str(), i);
+				return false;
+			}
+		}
+
+		//The base world has already been set up, do the same for everything the delta added to it.
+		for (Actor* actor : spawnedActors)
+		{
+			actor->Create();
+			actor->CreateAllComponents();
+			actor->PostCreate();
+		}
+
+		for (Component* component : spawnedComponents)
+		{
+			Actor* owner = component->GetOwner();
+			if (owner == nullptr || std::find(spawnedActors.begin(), spawnedActors.end(), owner) == spawnedActors.end())
+			{
+				component->Create();
+			}
+		}
+
+		return true;
+	}
+
+	std::string GetFilename(const std::string& worldFilename)
+	{
+		return "GameSaves/" + worldFilename.substr(0, worldFilename.find_first_of(".")) + fileExtension;
+	}
+};
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "Actors/ActorHandle.h"
+
+class Actor;
+
+//Game saves as a delta on top of the world they were played from, instead of a full copy of every system.
+//
+//Once tracking has begun, actors are flagged dirty through Actor::MarkSaveDirty() (transform setters,
+//SetActive(), SetName(), etc.) and on spawn. Destroying an actor that was in the base world leaves a tombstone.
+//Save() then only writes records for dirty actors (and all their components) plus the tombstones, so a save file
+//holds what's changed instead of the whole world.
+//
+//Props don't all go through setters (e.g. Unit health), so BeginTracking() also keeps a hash of each base actor's
+//records and Save() flags any clean actor whose records no longer hash the same. Nothing has to remember to call
+//MarkSaveDirty(), it only saves the compare for actors already known to have changed.
+//
+//Dirty state is kept since the base world was loaded, not since the last save, so each delta stands on its own.
+//Components removed from surviving actors aren't recorded.
+//
+//Layout: [Header][base world name][tombstone UIDs][actor sections][component sections]
+//Actor sections are the system name, the actors' UIDs then a PropsSchema header and records.
+//Component sections are the system name, each component's owner UID and name then a header and records.
+//Strings in records are inline, deltas are small enough that a string pool isn't worth it.
+namespace WorldDelta
+{
+	inline constexpr uint32_t magic = 0x544C4456; //"VDLT"
+	inline constexpr uint32_t version = 1;
+	inline constexpr const char* fileExtension = ".vdelta";
+
+	struct Header
+	{
+		uint32_t magic = WorldDelta::magic;
+		uint32_t version = WorldDelta::version;
+		uint32_t numTombstones = 0;
+		uint32_t numActorSections = 0;
+		uint32_t numComponentSections = 0;
+		uint32_t reserved = 0;
+	};
+
+	//Everything tracked for a world, for worlds that are set aside and picked back up later (see WorldCache).
+	struct TrackingState
+	{
+		bool tracking = false;
+		std::string baseWorldFilename;
+		std::unordered_map<uint64_t, size_t> baseActors; //UID to the hash of its records when tracking began
+		std::unordered_set<uint64_t> tombstones;
+		std::vector<ActorHandle<Actor>> dirtyActors;
+	};
+
+	//Call once the base world is loaded. Every actor in the world now counts as part of the base.
+	void BeginTracking(const std::string& baseWorldFilename);
+	void EndTracking();
+	bool IsTracking();
+
+	//Stops tracking and hands over what's been tracked so far. Dirty flags stay on the actors.
+	TrackingState SuspendTracking();
+	void ResumeTracking(TrackingState&& state);
+
+	//Called by Actor::MarkSaveDirty() the first time the actor is flagged.
+	void OnActorDirtied(Actor* actor);
+
+	//Called by ActorSystem as actors are added and released.
+	void OnActorSpawned(Actor* actor);
+	void OnActorRemoved(Actor* actor);
+
+	//Fails without writing anything if a dirty actor or component's props have a type records can't hold.
+	bool Save(const std::string& filename);
+
+	//Applies a delta from Save() on top of the loaded base world. Call after BeginTracking() so whatever the delta
+	//holds stays dirty for the next save. Fails if the delta was saved against a different base world, is cut short
+	//or names a system that doesn't exist. Every section is checked first, so a failed Apply() leaves the base world as is.
+	bool Apply(const std::string& filename);
+
+	//GameSaves/<world name without extension>.vdelta
+	std::string GetFilename(const std::string& worldFilename);
+};
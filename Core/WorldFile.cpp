@@ -0,0 +1,349 @@
+#include "vpch.h"
+#include "WorldFile.h"
+#include <fstream>
+#include <vector>
+#include "Log.h"
+#include "FileSystem.h"
+#include "MappedFile.h"
+#include "PropsSchema.h"
+#include "UIDIndex.h"
+#include "Actors/Actor.h"
+#include "Actors/IActorSystem.h"
+#include "Actors/ActorSystemCache.h"
+#include "Components/Component.h"
+#include "Components/IComponentSystem.h"
+#include "Components/ComponentSystemCache.h"
+
+namespace WorldFile
+{
+	//Sections start on 8 byte boundaries so fixed records line up in the mapped pages.
+	void AlignTo8(std::string& bytes)
+	{
+		bytes.resize((bytes.size() + 7) & ~size_t(7), '\0');
+	}
+
+	bool CheckRecordable(const std::string& systemName, const PropsSchema& schema)
+	{
+		if (schema.IsRecordable())
+		{
+			return true;
+		}
+
+		for (const std::string& fieldName : schema.GetUnrecordableFields())
+		{
+			Log("WorldFile: [%s] property [%s] has no record type, register a codec with PropsSchema::RegisterFieldCodec().",
+				systemName.c_str(), fieldName.c_str());
+		}
+
+		return false;
+	}
+
+	void AddSection(std::string& body, std::vector<SectionEntry>& toc, StringPool& stringPool,
+		SectionKind kind, const std::string& systemName, uint32_t numRecords, const PackedRecords& records)
+	{
+		AlignTo8(body);
+
+		SectionEntry& section = toc.emplace_back();
+		section.kind = kind;
+		section.numRecords = numRecords;
+		section.systemNameOffset = stringPool.Add(systemName.data(), systemName.size());
+		section.systemNameLength = static_cast<uint32_t>(systemName.size());
+		section.offset = sizeof(Header) + body.size();
+		section.size = records.GetBytes().size();
+
+		body.append(records.GetBytes());
+	}
+
+	bool Write(const std::string& filename)
+	{
+		StringPool stringPool;
+		std::string body;
+		std::vector<SectionEntry> toc;
+		bool allRecordable = true;
+
+		for (IActorSystem* actorSystem : ActorSystemCache::Get().GetSystemList())
+		{
+			const uint32_t numActors = actorSystem->GetNumActors();
+			if (numActors == 0)
+			{
+				continue;
+			}
+
+			if (!CheckRecordable(actorSystem->GetName(), actorSystem->GetPropsSchema()))
+			{
+				allRecordable = false;
+				continue;
+			}
+
+			PackedRecords records;
+			records.SetStringPool(&stringPool);
+			actorSystem->WriteRecords(records);
+
+			AddSection(body, toc, stringPool, SectionKind::ActorSystem, actorSystem->GetName(), numActors, records);
+		}
+
+		for (IComponentSystem* componentSystem : ComponentSystemCache::Get().GetAllSystems())
+		{
+			const uint32_t numComponents = componentSystem->GetNumComponents();
+			if (numComponents == 0)
+			{
+				continue;
+			}
+
+			if (!CheckRecordable(componentSystem->GetName(), componentSystem->GetPropsSchema()))
+			{
+				allRecordable = false;
+				continue;
+			}
+
+			PackedRecords records;
+			records.SetStringPool(&stringPool);
+
+			for (Component* component : componentSystem->GetComponentsAsBaseClass())
+			{
+				ComponentOwnerRecord ownerRecord;
+				ownerRecord.ownerUID = static_cast<uint64_t>(component->GetOwnerUID());
+				ownerRecord.nameOffset = stringPool.Add(component->name.data(), component->name.size());
+				ownerRecord.nameLength = static_cast<uint32_t>(component->name.size());
+				records.Write(ownerRecord);
+			}
+
+			componentSystem->WriteRecords(records);
+
+			AddSection(body, toc, stringPool, SectionKind::ComponentSystem, componentSystem->GetName(), numComponents, records);
+		}
+
+		if (!allRecordable)
+		{
+			return false;
+		}
+
+		AlignTo8(body);
+
+		Header header;
+		header.numSections = static_cast<uint32_t>(toc.size());
+		header.stringPoolOffset = sizeof(Header) + body.size();
+		header.stringPoolSize = stringPool.GetBytes().size();
+		header.tocOffset = (header.stringPoolOffset + header.stringPoolSize + 7) & ~uint64_t(7);
+
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			return false;
+		}
+
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(body.data(), body.size());
+		file.write(stringPool.GetBytes().data(), stringPool.GetBytes().size());
+
+		const std::string tocPadding(header.tocOffset - header.stringPoolOffset - header.stringPoolSize, '\0');
+		file.write(tocPadding.data(), tocPadding.size());
+		file.write(reinterpret_cast<const char*>(toc.data()), toc.size() * sizeof(SectionEntry));
+
+		return file.good();
+	}
+
+	//Offsets and lengths come straight from the file, checked this way round so they can't wrap.
+	bool FitsIn(uint64_t offset, uint64_t length, uint64_t size)
+	{
+		return offset <= size && length <= size - offset;
+	}
+
+	//Checks the header and table of contents fit in the file.
+	bool ValidateHeader(const MappedFile& file, const Header*& header)
+	{
+		if (file.GetSize() < sizeof(Header))
+		{
+			return false;
+		}
+
+		header = reinterpret_cast<const Header*>(file.GetData());
+		if (header->magic != magic)
+		{
+			return false;
+		}
+
+		if (header->version != version)
+		{
+			Log("WorldFile: version %u isn't supported, expected %u.", header->version, version);
+			return false;
+		}
+
+		return FitsIn(header->stringPoolOffset, header->stringPoolSize, file.GetSize())
+			&& FitsIn(header->tocOffset, static_cast<uint64_t>(header->numSections) * sizeof(SectionEntry), file.GetSize());
+	}
+
+	void LoadActorSection(const SectionEntry& section, const std::string& systemName, PackedRecords& records)
+	{
+		IActorSystem* actorSystem = ActorSystemCache::Get().GetSystem(systemName);
+		if (actorSystem == nullptr)
+		{
+			Log("WorldFile: no actor system [%s], skipping %u actors.", systemName.c_str(), section.numRecords);
+			return;
+		}
+
+		const uint32_t firstIndex = actorSystem->GetNumActors();
+		actorSystem->SpawnBatch(section.numRecords, {});
+		actorSystem->ReadRecords(records, firstIndex);
+
+		//Components added in constructors took the UID the actors had before their records were read.
+		for (uint32_t i = firstIndex; i < actorSystem->GetNumActors(); i++)
+		{
+			Actor* actor = actorSystem->GetActorByIndex(i);
+			for (Component* component : actor->GetAllComponents())
+			{
+				component->SetOwnerUID(actor->GetUID());
+			}
+		}
+	}
+
+	//Returns false if the owner table is cut short, a missing system is only skipped.
+	bool LoadComponentSection(const SectionEntry& section, const std::string& systemName, PackedRecords& records,
+		const char* stringPool, size_t stringPoolSize)
+	{
+		IComponentSystem* componentSystem = ComponentSystemCache::Get().GetSystem(systemName);
+		if (componentSystem == nullptr)
+		{
+			Log("WorldFile: no component system [%s], skipping %u components.", systemName.c_str(), section.numRecords);
+			return true;
+		}
+
+		std::vector<Component*> targets;
+		targets.reserve(section.numRecords);
+
+		for (uint32_t i = 0; i < section.numRecords; i++)
+		{
+			ComponentOwnerRecord ownerRecord;
+			if (!records.Read(ownerRecord) || !FitsIn(ownerRecord.nameOffset, ownerRecord.nameLength, stringPoolSize))
+			{
+				Log("WorldFile: [%s] owner table is truncated.", systemName.c_str());
+				return false;
+			}
+
+			const std::string componentName(stringPool + ownerRecord.nameOffset, ownerRecord.nameLength);
+			Actor* owner = UIDIndex::FindActor(static_cast<UID>(ownerRecord.ownerUID));
+
+			//Components created in the owner's constructor already exist, fill those in.
+			Component* component = owner ? owner->GetComponentByName(componentName) : nullptr;
+			if (component == nullptr || component->GetComponentSystem() != componentSystem)
+			{
+				//Named before it's added to the owner, actors index their components by name.
+				component = componentSystem->SpawnComponent(nullptr);
+				component->name = componentName;
+
+				if (owner)
+				{
+					owner->AddComponent(component);
+				}
+				else
+				{
+					component->SetOwnerUID(static_cast<UID>(ownerRecord.ownerUID));
+				}
+			}
+
+			targets.emplace_back(component);
+		}
+
+		componentSystem->ReadRecords(records, targets);
+		return true;
+	}
+
+	bool Load(const std::string& filename)
+	{
+		MappedFile file;
+		if (!file.Open(filename))
+		{
+			Log("WorldFile: couldn't map [%s].", filename.c_str());
+			return false;
+		}
+
+		return Load(file, filename);
+	}
+
+	bool Load(const MappedFile& file, const std::string& filename)
+	{
+		const Header* header = nullptr;
+		if (!ValidateHeader(file, header))
+		{
+			Log("WorldFile: [%s] isn't a valid binary world.", filename.c_str());
+			return false;
+		}
+
+		const char* stringPool = file.GetData() + header->stringPoolOffset;
+		const size_t stringPoolSize = static_cast<size_t>(header->stringPoolSize);
+		const SectionEntry* toc = reinterpret_cast<const SectionEntry*>(file.GetData() + header->tocOffset);
+
+		for (uint32_t sectionIndex = 0; sectionIndex < header->numSections; sectionIndex++)
+		{
+			const SectionEntry& section = toc[sectionIndex];
+			if (!FitsIn(section.offset, section.size, file.GetSize())
+				|| !FitsIn(section.systemNameOffset, section.systemNameLength, stringPoolSize))
+			{
+				Log("WorldFile: [%s] section %u is out of bounds.", filename.c_str(), sectionIndex);
+				return false;
+			}
+
+			const std::string systemName(stringPool + section.systemNameOffset, section.systemNameLength);
+
+			//Records are read straight out of the mapped pages.
+			PackedRecords records(file.GetData() + section.offset, static_cast<size_t>(section.size));
+			records.SetStringPoolView(stringPool, stringPoolSize);
+
+			if (section.kind == SectionKind::ActorSystem)
+			{
+				LoadActorSection(section, systemName, records);
+			}
+			else if (!LoadComponentSection(section, systemName, records, stringPool, stringPoolSize))
+			{
+				Log("WorldFile: [%s] section %u is truncated.", filename.c_str(), sectionIndex);
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Validate(const MappedFile& file)
+	{
+		const Header* header = nullptr;
+		if (!ValidateHeader(file, header))
+		{
+			return false;
+		}
+
+		const SectionEntry* toc = reinterpret_cast<const SectionEntry*>(file.GetData() + header->tocOffset);
+		for (uint32_t sectionIndex = 0; sectionIndex < header->numSections; sectionIndex++)
+		{
+			const SectionEntry& section = toc[sectionIndex];
+			if (!FitsIn(section.offset, section.size, file.GetSize())
+				|| !FitsIn(section.systemNameOffset, section.systemNameLength, header->stringPoolSize))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool IsWorldFile(const std::string& filename)
+	{
+		std::ifstream file(filename, std::ios::in | std::ios::binary);
+
+		Header header;
+		file.read(reinterpret_cast<char*>(&header), sizeof(header));
+		return file.good() && header.magic == magic;
+	}
+
+	bool ConvertTextWorld(const std::string& textWorldName, const std::string& outputFilename)
+	{
+		FileSystem::LoadWorld(textWorldName);
+
+		if (!Write(outputFilename))
+		{
+			Log("WorldFile: couldn't convert [%s], see above for properties without record types.", textWorldName.c_str());
+			return false;
+		}
+
+		return true;
+	}
+};
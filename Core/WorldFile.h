@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+class MappedFile;
+
+//Binary .vmap format, loaded by memory mapping the file and reading records straight out of the mapped pages.
+//
+//Layout: [Header][sections...][string pool][table of contents]
+//The table of contents has one entry per non-empty actor/component system, actor systems first.
+//Each section is a PropsSchema header followed by one fixed size record per object, strings in records
+//are offsets into the string pool. Component sections start with a fixed size owner table (owner UID and
+//component name per record) so components can be matched to or spawned on their owners before records are read.
+//
+//Text .vmaps (FileSystem) stay the editor-friendly export. ConvertTextWorld() turns one into this format.
+namespace WorldFile
+{
+	inline constexpr uint32_t magic = 0x50414D56; //"VMAP"
+	inline constexpr uint32_t version = 1;
+
+	struct Header
+	{
+		uint32_t magic = WorldFile::magic;
+		uint32_t version = WorldFile::version;
+		uint32_t numSections = 0;
+		uint32_t reserved = 0;
+		uint64_t tocOffset = 0;
+		uint64_t stringPoolOffset = 0;
+		uint64_t stringPoolSize = 0;
+	};
+
+	enum class SectionKind : uint32_t
+	{
+		ActorSystem,
+		ComponentSystem,
+	};
+
+	struct SectionEntry
+	{
+		SectionKind kind = SectionKind::ActorSystem;
+		uint32_t numRecords = 0;
+		uint32_t systemNameOffset = 0;
+		uint32_t systemNameLength = 0;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+	};
+
+	struct ComponentOwnerRecord
+	{
+		uint64_t ownerUID = 0;
+		uint32_t nameOffset = 0;
+		uint32_t nameLength = 0;
+	};
+
+	//Writes every actor and component system. Fails without writing anything if a system's props
+	//have a type records can't hold (those are logged, see PropsSchema::RegisterFieldCodec()).
+	bool Write(const std::string& filename);
+
+	//Spawns and reads in everything in the file on top of what's in the systems. Call on cleaned up
+	//systems in place of the binary deserialise pass, world setup (Init(), Start(), etc.) stays with the caller.
+	//Returns false on a section that's out of bounds or cut short, with whatever came before it already spawned.
+	bool Load(const std::string& filename);
+
+	//Same as above from a file that's already mapped, e.g. one staged by AsyncWorldLoader.
+	bool Load(const MappedFile& file, const std::string& filename);
+
+	//Checks the header, table of contents and every section fit in the file without loading anything.
+	//Doesn't touch any systems, so it's safe off the main thread.
+	bool Validate(const MappedFile& file);
+
+	//Checks the header without loading, e.g. to pick between this and the text loader.
+	bool IsWorldFile(const std::string& filename);
+
+	//Loads the text world through FileSystem and writes it back out with Write(). See Tools/WorldConverter.cpp.
+	bool ConvertTextWorld(const std::string& textWorldName, const std::string& outputFilename);
+};
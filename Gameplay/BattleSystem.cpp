@@ -1,11 +1,14 @@
 #include "vpch.h"
 #include "BattleSystem.h"
+#include <cmath>
 #include "Core/World.h"
 #include "Core/Log.h"
 #include "Actors/Game/Unit.h"
 #include "Actors/Game/Player.h"
 #include "Actors/Game/Grid.h"
 #include "Actors/Game/NPC.h"
+#include "Actors/Game/PlayerUnit.h"
+#include "Actors/Game/EntranceTrigger.h"
 #include "Gameplay/GameUtils.h"
 #include "Gameplay/PlayerInputController.h"
 #include "UI/UISystem.h"
@@ -13,6 +16,7 @@
 #include "UI/Game/DialogueWidget.h"
 #include "UI/Game/UnitLineupWidget.h"
 #include "UI/Game/PlayerHealthWidget.h"
+#include "Actors/ActorTypeQuery.h"
 
 BattleSystem battleSystem;
 
@@ -23,6 +27,7 @@ BattleSystem::BattleSystem()
 void BattleSystem::Reset()
 {
 	isBattleActive = false;
+	ActorTickScheduler::lodEnabled = true;
 
 	grid = nullptr;
 	player = nullptr;
@@ -40,6 +45,9 @@ void BattleSystem::StartBattle()
 
 	isBattleActive = true;
 
+	//Every unit takes part in turn order, so nothing gets tick LOD during battle.
+	ActorTickScheduler::lodEnabled = false;
+
 	grid = Grid::system.GetFirstActor();
 	grid->lerpValue = Grid::LerpValue::LerpOut;
 	grid->SetActive(true);
@@ -50,14 +58,14 @@ void BattleSystem::StartBattle()
 
 	UISystem::unitLineupWidget->AddToViewport();
 
-	activeBattleUnits = World::GetAllActorsOfTypeInWorld<Unit>();
-	for (auto unit : activeBattleUnits)
+	activeBattleUnits.clear();
+	for (auto unit : ActorQueryRegistry::GetActorsOfType<Unit>())
 	{
 		unit->isInBattle = true;
+		activeBattleUnits.emplace_back(unit);
 	}
 
-	auto activeBattleNPCs = World::GetAllActorsOfTypeInWorld<NPC>();
-	for (auto npc : activeBattleNPCs)
+	for (auto npc : ActorQueryRegistry::GetActorsOfType<NPC>())
 	{
 		npc->BattleStartDialogue();
 	}
@@ -80,6 +88,7 @@ void BattleSystem::EndBattle()
 	Log("Battle ended.");
 
 	isBattleActive = false;
+	ActorTickScheduler::lodEnabled = true;
 
 	grid->ResetAllNodes();
 	grid->DisplayHideAllNodes();
@@ -102,6 +111,8 @@ void BattleSystem::MoveToNextTurn()
 	{
 		Log("Players turn");
 
+		CheckDistanceFieldBuilds();
+
 		battleSystem.isPlayerTurn = true;
 
 		player->RefreshCombatStats();
@@ -117,6 +128,16 @@ void BattleSystem::MoveToNextTurn()
 		return;
 	}
 
+	//Start of the enemy turns, the player units have all moved.
+	if (currentUnitTurnIndex == 0)
+	{
+		numPlayerUnitFieldBuilds = 0;
+		numEntranceFieldBuilds = 0;
+
+		BuildPlayerUnitField();
+		BuildEntranceField();
+	}
+
 	battleSystem.isPlayerTurn = false;
 
 	//next enemy turn
@@ -159,3 +180,83 @@ bool BattleSystem::CheckIfBattleIsOver()
 {
 	return activeBattleUnits.size() == 0;
 }
+
+const GridDistanceField& BattleSystem::GetPlayerUnitField()
+{
+	if (grid && !grid->IsDistanceFieldCurrent(playerUnitField))
+	{
+		BuildPlayerUnitField();
+	}
+
+	return playerUnitField;
+}
+
+const GridDistanceField& BattleSystem::GetEntranceField()
+{
+	if (grid && !grid->IsDistanceFieldCurrent(entranceField))
+	{
+		BuildEntranceField();
+	}
+
+	return entranceField;
+}
+
+EntranceTrigger* BattleSystem::GetClosestEntrance(GridNode* node)
+{
+	const GridDistanceField& field = GetEntranceField();
+	if (grid == nullptr || field.sourceIndices.size() != grid->nodes.size())
+	{
+		return nullptr;
+	}
+
+	const int sourceIndex = field.sourceIndices[grid->GetNodeIndex(node)];
+	return sourceIndex >= 0 ? entranceFieldSources[sourceIndex] : nullptr;
+}
+
+void BattleSystem::BuildPlayerUnitField()
+{
+	std::vector<GridNode*> sources;
+
+	for (auto playerUnit : ActorQueryRegistry::GetActorsOfType<PlayerUnit>())
+	{
+		GridNode* node = grid->GetNodeAllowNull(playerUnit->xIndex, playerUnit->yIndex);
+		if (node)
+		{
+			sources.emplace_back(node);
+		}
+	}
+	grid->BuildDistanceField(sources, playerUnitField);
+	numPlayerUnitFieldBuilds++;
+}
+
+void BattleSystem::BuildEntranceField()
+{
+	std::vector<GridNode*> sources;
+	entranceFieldSources.clear();
+
+	//EntranceTriggers aren't grid actors, use whichever node they're over. The grid sits at the origin.
+	for (auto& entrance : EntranceTrigger::system.GetActors())
+	{
+		const XMFLOAT3 position = entrance->GetPosition();
+		GridNode* node = grid->GetNodeAllowNull(static_cast<int>(std::lround(position.x)),
+			static_cast<int>(std::lround(position.z)));
+		if (node)
+		{
+			sources.emplace_back(node);
+			entranceFieldSources.emplace_back(entrance.get());
+		}
+	}
+	grid->BuildDistanceField(sources, entranceField);
+	numEntranceFieldBuilds++;
+}
+
+void BattleSystem::CheckDistanceFieldBuilds()
+{
+	//More than one build means something other than terrain is making the fields stale and each Unit pays for a full
+	//grid flood again. Terrain changing mid phase (e.g. an obstacle destroyed) is the only expected reason.
+	if (numPlayerUnitFieldBuilds > 1 || numEntranceFieldBuilds > 1)
+	{
+		Log("BattleSystem: distance fields built more than once in one enemy phase (player units %u, entrances %u).",
+			numPlayerUnitFieldBuilds, numEntranceFieldBuilds);
+	}
+}
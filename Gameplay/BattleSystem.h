@@ -1,10 +1,12 @@
 #pragma once
 
 #include <vector>
+#include "Gameplay/GridNode.h"
 
 struct Unit;
 class Player;
 struct Grid;
+struct EntranceTrigger;
 struct PlayerActionBarWidget;
 
 //Handles all units and player turns for battle as well as what units are active.
@@ -24,6 +26,20 @@ private:
 
 	int currentUnitTurnIndex = 0;
 
+	//Built at the start of the enemy turns so each Unit walks a field instead of searching the grid itself.
+	//Rebuilt on the next get if nodes have been shown, hidden or moved since (e.g. the last Unit moved).
+	GridDistanceField playerUnitField;
+	GridDistanceField entranceField;
+	std::vector<EntranceTrigger*> entranceFieldSources;
+
+	//Each field should only be built once an enemy phase unless the terrain changes, checked at the end of the phase.
+	uint32_t numPlayerUnitFieldBuilds = 0;
+	uint32_t numEntranceFieldBuilds = 0;
+
+	void BuildPlayerUnitField();
+	void BuildEntranceField();
+	void CheckDistanceFieldBuilds();
+
 public:
 	BattleSystem();
 	void Reset();
@@ -32,6 +48,13 @@ public:
 	void MoveToNextTurn();
 	void RemoveUnit(Unit* unit);
 	bool CheckIfBattleIsOver();
+
+	//Distance to the nearest PlayerUnit, for Units fighting or evading.
+	const GridDistanceField& GetPlayerUnitField();
+
+	//Distance to the nearest EntranceTrigger, for escaping Units.
+	const GridDistanceField& GetEntranceField();
+	EntranceTrigger* GetClosestEntrance(GridNode* node);
 };
 
 extern BattleSystem battleSystem;
@@ -13,6 +13,7 @@
 #include "Audio/AudioSystem.h"
 #include "Actors/Game/EntranceTrigger.h"
 #include "Actors/Game/Player.h"
+#include "Actors/ActorNameIndex.h"
 #include "Components/MeshComponent.h"
 
 ConditionSystem conditionSystem;
@@ -36,7 +37,7 @@ bool AttackUp(std::string arg)
 
 bool UnlockEntrance(std::string arg)
 {
-	Actor* actor = World::GetActorByName(arg);
+	Actor* actor = ActorNameIndex::Find(arg);
 	auto entranceTrigger = dynamic_cast<EntranceTrigger*>(actor);
 	assert(entranceTrigger);
 	entranceTrigger->UnlockEntrance();
@@ -1,5 +1,6 @@
 #include "vpch.h"
 #include "GameInstance.h"
+#include "Core/Reflection.h"
 
 std::string GameInstance::startingMap = "test.vmap";
 
@@ -11,17 +12,24 @@ static std::string secondaryGear;
 
 static DirectX::XMFLOAT3 playerMapScreenPos;
 
-Properties GameInstance::GetGlobalProps()
-{
-	Properties props("GameInstance");
-	props.Add("Continue Map", &mapToLoadOnContinue);
+REFLECT_FIELDS(GameInstance,
+	ReflectGlobal("Continue Map", &GameInstance::mapToLoadOnContinue),
 
-	props.Add("RamielDefeated", &ramielDefeated);
+	ReflectGlobal("RamielDefeated", &ramielDefeated),
 
-	props.Add("PrimaryGear", &primaryGear);
-	props.Add("SecondaryGear", &secondaryGear);
+	ReflectGlobal("PrimaryGear", &primaryGear),
+	ReflectGlobal("SecondaryGear", &secondaryGear),
 
-	props.Add("PlayerMapScreenPos", &playerMapScreenPos);
+	ReflectGlobal("PlayerMapScreenPos", &playerMapScreenPos))
 
+Properties GameInstance::GetGlobalProps()
+{
+	Properties props("GameInstance");
+	Reflection::AddFields<GameInstance>(props, nullptr);
 	return props;
 }
+
+void* GameInstance::FindGlobalProp(const std::string& name, const std::type_info& type)
+{
+	return Reflection::FindFieldData<GameInstance>(nullptr, name, type);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <typeinfo>
 #include "Core/Properties.h"
 
 class Memory;
@@ -24,19 +25,22 @@ struct GameInstance
 	//Global save data
 	static Properties GetGlobalProps();
 
+	//Looked up in the reflected global table, doesn't build the Properties.
 	template <typename T>
 	static T* GetGlobalProp(const std::string name)
 	{
-		Properties globalProps = GetGlobalProps();
-		T* data = globalProps.GetData<T>(name);
+		T* data = static_cast<T*>(FindGlobalProp(name, typeid(T)));
 		return data;
 	}
 
 	template <typename T>
 	static void SetGlobalProp(const std::string name, T value)
 	{
-		Properties globalProps = GetGlobalProps();
-		T* data = globalProps.GetData<T>(name);
+		T* data = static_cast<T*>(FindGlobalProp(name, typeid(T)));
+		assert(data);
 		*data = value;
 	}
+
+private:
+	static void* FindGlobalProp(const std::string& name, const std::type_info& type);
 };
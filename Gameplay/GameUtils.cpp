@@ -5,6 +5,9 @@
 #include "Audio/AudioSystem.h"
 #include "Core/World.h"
 #include "Core/FileSystem.h"
+#include "Core/WorldDelta.h"
+#include "Core/AsyncWorldLoader.h"
+#include "Core/WorldCache.h"
 #include "GameInstance.h"
 #include "Core/Camera.h"
 #include "Components/CameraComponent.h"
@@ -100,12 +103,47 @@ namespace GameUtils
 		//and the .sav version of it is based on in-game player saves. So if a .sav version exists, that is loaded
 		//instead of the .vmap file, during gameplay.
 
+		//Only what's changed since the world was loaded is saved where possible, applied on top of it on load.
+		//Worlds with props the delta can't hold fall back to a full .sav.
+		const std::string deltaFilename = WorldDelta::GetFilename(World::worldFilename);
+		if (WorldDelta::Save(deltaFilename))
+		{
+			return;
+		}
+
+		//The full save already has any changes the old delta held.
+		std::filesystem::remove(deltaFilename);
+
 		auto firstOf = World::worldFilename.find_first_of(".");
 		std::string str = World::worldFilename.substr(0, firstOf);
 		std::string file = str += AssetFileExtensions::gameSave;
 
 		World::worldFilename = file;
 		FileSystem::SerialiseAllSystems();
+
+		//Later deltas build on the .sav just written, not the world as it was first loaded.
+		WorldDelta::BeginTracking(World::worldFilename);
+	}
+
+	std::string GetFullGameSavePath(const std::string& worldName)
+	{
+		return "GameSaves/" + worldName.substr(0, worldName.find_first_of(".")) + AssetFileExtensions::gameSave;
+	}
+
+	void LoadGameWorldState()
+	{
+		WorldDelta::BeginTracking(World::worldFilename);
+
+		if (GameInstance::useGameSaves)
+		{
+			const std::string deltaFilename = WorldDelta::GetFilename(World::worldFilename);
+			if (std::filesystem::exists(deltaFilename) && !WorldDelta::Apply(deltaFilename))
+			{
+				//Nothing was applied, carry on in the base world rather than leaving the save half loaded.
+				Log("GameUtils: couldn't apply [%s], [%s] is loaded without its save.",
+					deltaFilename.c_str(), World::worldFilename.c_str());
+			}
+		}
 	}
 
 	void LoadWorldDeferred(std::string worldName)
@@ -126,6 +164,9 @@ namespace GameUtils
 		Properties instanceProps = GameInstance::GetGlobalProps();
 		Deserialiser d(gameInstanceSaveFile, OpenMode::In);
 		d.Deserialise(instanceProps);
+
+		//Cached worlds were left with the old global state.
+		WorldCache::Clear();
 	}
 
 	void LoadWorldAndMoveToEntranceTrigger()
@@ -135,7 +176,9 @@ namespace GameUtils
 			return;
 		}
 
-		LoadWorldDeferred(levelToMoveTo);
+		//Timers fire mid frame, the swap waits until systems are done ticking.
+		//Worlds that weren't staged as binary worlds load through FileSystem from there.
+		AsyncWorldLoader::QueueSwapIn(levelToMoveTo);
 
 		Input::blockInput = false;
 	}
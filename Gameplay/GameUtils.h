@@ -32,6 +32,13 @@ namespace GameUtils
 
 	void SaveGameWorldState();
 
+	//Where SaveGameWorldState() writes a full save for worldName when a delta can't hold the world.
+	std::string GetFullGameSavePath(const std::string& worldName);
+
+	//Applies the world's game save delta (if there is one) and starts tracking changes for the next save.
+	//Called on world start, see WorldFunctions::CallWorldStartFunction().
+	void LoadGameWorldState();
+
 	//Loads world at the end of the current frame. Call FileSystem::LoadWorld() if immediate loading is needed.
 	void LoadWorldDeferred(std::string worldName);
 
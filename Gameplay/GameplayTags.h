@@ -1,15 +1,15 @@
 #pragma once
 
-#include <string>
+#include "Core/Symbol.h"
 
 struct GameplayTags
 {
 	//For all Destroy()'able meshes on an Enemy. When all are gone, destroy the Enemy.
-	inline static const std::string EnemyMeshPiece = "EnemyMeshPiece";
+	inline static const Symbol EnemyMeshPiece = Symbol("EnemyMeshPiece");
 
 	//Tag that denotes that the mesh that can't be destroyed.
-	inline static const std::string InvincibleMeshPiece = "InvincibleMeshPiece";
+	inline static const Symbol InvincibleMeshPiece = Symbol("InvincibleMeshPiece");
 
 	//Actors that are targetable by player's aiming reticle
-	inline static const std::string TargetableActor = "TargetableActor";
+	inline static const Symbol TargetableActor = Symbol("TargetableActor");
 };
@@ -63,7 +63,7 @@ void GridNode::RecalcNodeHeight(HitResult& hitResult)
 		hitPosVector.m128_f32[3] = 1.0f;
 
 		//set the y-pos for the node
-		worldPosition.y = hitPos.y + 0.4f;
+		grid->SetNodeHeight(this, hitPos.y + 0.4f);
 
 		meshInstanceData.world.r[3] = hitPosVector;
 	}
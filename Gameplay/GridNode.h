@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <vector>
 #include <DirectXMath.h>
 
 using namespace DirectX;
@@ -7,6 +9,37 @@ using namespace DirectX;
 struct HitResult;
 struct TrapCard;
 
+//Per node scratch for path searches, kept in Grid::searchNodes apart from the nodes so searches
+//only walk what they read. Reset with Grid::ResetAllNodes().
+struct GridSearchNode
+{
+	float GetFCost()
+	{
+		return gCost + hCost;
+	}
+
+	float gCost = 0.f; //Distance from start node
+	float hCost = 0.f; //Distance to end node
+	int parentIndex = -1; //Into Grid::nodes
+
+	//Grid::FindPath()/FindReachableNodes() call that last touched this node, older values are stale.
+	uint32_t searchID = 0;
+	bool expanded = false;
+
+	bool closed = false; //For GetNeighbouringNodes()
+};
+
+//Steps from every node to the nearest of a set of source nodes, see Grid::BuildDistanceField().
+//Both are indexed the same as Grid::nodes.
+struct GridDistanceField
+{
+	std::vector<int> distances; //-1 where no source can be reached from
+	std::vector<int> sourceIndices; //Into the sources the field was built from
+
+	//Grid::nodeStateVersion when the field was built, see Grid::IsDistanceFieldCurrent().
+	uint32_t nodeStateVersion = 0;
+};
+
 struct GridNode
 {
 	GridNode() {}
@@ -30,20 +63,6 @@ struct GridNode
 		return (node->xIndex == xIndex) && (node->yIndex == yIndex);
 	}
 
-	float GetFCost()
-	{
-		return gCost + hCost;
-	}
-
-	void ResetValues()
-	{
-		gCost = 0.f;
-		hCost = 0.f;
-		parentNode = nullptr;
-		closed = false;
-		preview = false;
-	}
-
 	//These functions also sets the nodes variables
 	void Hide();
 	void Show();
@@ -58,7 +77,7 @@ struct GridNode
 
 	void SetColour(XMFLOAT4 newColour);
 
-	GridNode* parentNode = nullptr;
+	//y is mirrored in Grid::nodeHeights for neighbour searches, set it through RecalcNodeHeight() or Grid.
 	XMFLOAT3 worldPosition = XMFLOAT3(0.f, 0.f, 0.f);
 
 	XMVECTOR GetWorldPosV() { return XMLoadFloat3(&worldPosition); }
@@ -71,12 +90,9 @@ struct GridNode
 	inline static XMFLOAT4 previewColour = XMFLOAT4(0.89f, 0.07f, 0.07f, 0.4f);
 	inline static XMFLOAT4 trapNodeColour = XMFLOAT4(0.9f, 0.45f, 0.1f, 0.7f);
 
-	float gCost = 0.f; //Distance from start node
-	float hCost = 0.f; //Distance to end node
 	int xIndex = 0;
 	int yIndex = 0;
 	uint32_t instancedMeshIndex = 0;
-	bool closed = false;
-	bool active = true;
-	bool preview = false; //If the node is to show preview movements, ignores lerp
+	bool active : 1 = true;
+	bool preview : 1 = false; //If the node is to show preview movements, ignores lerp
 };
@@ -12,6 +12,9 @@ void WorldFunctions::SetupWorldStartFunctions()
 
 void WorldFunctions::CallWorldStartFunction(const std::string worldName)
 {
+	//Start functions see the world as it was saved.
+	GameUtils::LoadGameWorldState();
+
 	auto funcIt = worldStartFunctionMap.find(worldName);
 	if (funcIt != worldStartFunctionMap.end())
 	{
@@ -0,0 +1,46 @@
+#include "vpch.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include "Core/WorldFile.h"
+
+//Command line tool that converts text worlds into binary worlds (see WorldFile), e.g. as a step before packaging.
+//Build as a console executable with the engine's sources and run it from the game's working directory:
+//
+//	WorldConverter <output directory> <world> [<world> ...]
+//
+//Each world (e.g. "Level.vmap") is loaded from WorldMaps/ through FileSystem and written to the output directory
+//under the same name. Copy those over WorldMaps/ in the packaged game for AsyncWorldLoader to stage.
+//Returns the number of worlds that failed to convert.
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::printf("Usage: WorldConverter <output directory> <world> [<world> ...]\n");
+		return 1;
+	}
+
+	const std::filesystem::path outputDirectory = argv[1];
+	std::filesystem::create_directories(outputDirectory);
+
+	int numFailed = 0;
+
+	for (int argIndex = 2; argIndex < argc; argIndex++)
+	{
+		const std::string worldName = argv[argIndex];
+		const std::string outputFilename = (outputDirectory / worldName).string();
+
+		if (WorldFile::ConvertTextWorld(worldName, outputFilename))
+		{
+			std::printf("Converted [%s] to [%s].\n", worldName.c_str(), outputFilename.c_str());
+		}
+		else
+		{
+			std::printf("Couldn't convert [%s].\n", worldName.c_str());
+			numFailed++;
+		}
+	}
+
+	return numFailed;
+}